@@ -18,6 +18,7 @@
 #include "common/span.h"
 #include "common/types.h"
 
+#include <cstdint>
 #include <string_view>
 
 namespace WasmEdge {
@@ -30,9 +31,32 @@ public:
     Global,
     Local,
   };
+  /// Get the cache path of the data. The options which decide the cached
+  /// content, such as the compiler options, are hashed with the data.
   static Expect<std::filesystem::path>
-  getPath(Span<const Byte> Data, StorageScope Scope, std::string_view Key = {});
+  getPath(Span<const Byte> Data, StorageScope Scope, std::string_view Key = {},
+          std::string_view Options = {});
   static void clear(StorageScope Scope, std::string_view Key = {});
+
+  /// Update the last used time of the cached file for the eviction.
+  static void touch(const std::filesystem::path &Path) noexcept;
+  /// Remove the least recently used files in the directory of the cached file
+  /// until the total size is not larger than the limit.
+  static void prune(const std::filesystem::path &Path, uint64_t Limit) noexcept;
+
+  /// Exclusive lock of the cached file across the processes, held in the
+  /// lifetime. The cached file should be published by renaming a temporary
+  /// file in the same directory.
+  class Lock {
+  public:
+    explicit Lock(const std::filesystem::path &Path) noexcept;
+    ~Lock() noexcept;
+    Lock(const Lock &) = delete;
+    Lock &operator=(const Lock &) = delete;
+
+  private:
+    int FD = -1;
+  };
 };
 
 } // namespace AOT
@@ -0,0 +1,100 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2019-2022 Second State INC
+
+//===-- wasmedge/aot/target.h - Target level definition -------------------===//
+//
+// Part of the WasmEdge Project.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file contains the CPU feature levels of the AOT compiled code.
+///
+//===----------------------------------------------------------------------===//
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+namespace WasmEdge {
+namespace AOT {
+
+/// CPU feature level of the AOT code, recorded in the AOT section. A fat
+/// universal WASM contains the AOT sections of several levels, and the loader
+/// uses the highest level supported by the host.
+enum class TargetLevel : uint8_t {
+  /// Baseline of the architecture.
+  Generic = 0,
+  /// x86-64 micro-architecture levels.
+  X86_64_V2 = 1,
+  X86_64_V3 = 2,
+  X86_64_V4 = 3,
+  /// CPU of the compiling host. Not checked in loading.
+  Host = 0xFF,
+};
+
+/// Target levels of the fat universal WASM on this architecture, in the
+/// ascending order.
+static inline constexpr const TargetLevel kFatTargetLevels[] = {
+    TargetLevel::Generic,
+#if defined(__x86_64__) || defined(_M_X64)
+    TargetLevel::X86_64_V2,
+    TargetLevel::X86_64_V3,
+    TargetLevel::X86_64_V4,
+#endif
+};
+
+/// Getter of the CPU name of the target level for LLVM. Empty for the host.
+inline constexpr std::string_view
+getTargetCPUName(TargetLevel Level) noexcept {
+  switch (Level) {
+  case TargetLevel::Generic:
+    return "generic";
+  case TargetLevel::X86_64_V2:
+    return "x86-64-v2";
+  case TargetLevel::X86_64_V3:
+    return "x86-64-v3";
+  case TargetLevel::X86_64_V4:
+    return "x86-64-v4";
+  default:
+    return {};
+  }
+}
+
+/// Check the running host supports the code of the target level.
+inline bool isHostSupported(TargetLevel Level) noexcept {
+#if (defined(__x86_64__) || defined(_M_X64)) &&                               \
+    (defined(__GNUC__) || defined(__clang__))
+  // Only the features known by all the supported compilers are checked. The
+  // CPUs with these features have the other features of the levels.
+  switch (Level) {
+  case TargetLevel::X86_64_V4:
+    if (!__builtin_cpu_supports("avx512f") ||
+        !__builtin_cpu_supports("avx512bw") ||
+        !__builtin_cpu_supports("avx512cd") ||
+        !__builtin_cpu_supports("avx512dq") ||
+        !__builtin_cpu_supports("avx512vl")) {
+      return false;
+    }
+    [[fallthrough]];
+  case TargetLevel::X86_64_V3:
+    if (!__builtin_cpu_supports("avx") || !__builtin_cpu_supports("avx2") ||
+        !__builtin_cpu_supports("bmi") || !__builtin_cpu_supports("bmi2") ||
+        !__builtin_cpu_supports("fma")) {
+      return false;
+    }
+    [[fallthrough]];
+  case TargetLevel::X86_64_V2:
+    return __builtin_cpu_supports("popcnt") && __builtin_cpu_supports("sse3") &&
+           __builtin_cpu_supports("ssse3") &&
+           __builtin_cpu_supports("sse4.1") &&
+           __builtin_cpu_supports("sse4.2");
+  default:
+    break;
+  }
+#endif
+  return Level == TargetLevel::Generic || Level == TargetLevel::Host;
+}
+
+} // namespace AOT
+} // namespace WasmEdge
@@ -851,6 +851,230 @@ WasmEdge_ConfigureSetForceInterpreter(WasmEdge_ConfigureContext *Cxt,
 WASMEDGE_CAPI_EXPORT extern bool
 WasmEdge_ConfigureIsForceInterpreter(const WasmEdge_ConfigureContext *Cxt);
 
+/// Set the lazy validation mode option.
+///
+/// In lazy validation mode, the function bodies are decoded and validated at
+/// their first calls in the interpreter instead of in loading and validation.
+/// This option is ignored when the JIT is enabled.
+///
+/// This function is thread-safe.
+///
+/// \param Cxt the WasmEdge_ConfigureContext to set the boolean value.
+/// \param IsLazyValidation the boolean value to determine to decode and
+/// validate the function bodies lazily or not.
+WASMEDGE_CAPI_EXPORT extern void
+WasmEdge_ConfigureSetLazyValidation(WasmEdge_ConfigureContext *Cxt,
+                                    const bool IsLazyValidation);
+
+/// Get the lazy validation mode option.
+///
+/// This function is thread-safe.
+///
+/// \param Cxt the WasmEdge_ConfigureContext to get the boolean value.
+///
+/// \returns the boolean value to determine to decode and validate the function
+/// bodies lazily or not.
+WASMEDGE_CAPI_EXPORT extern bool
+WasmEdge_ConfigureIsLazyValidation(const WasmEdge_ConfigureContext *Cxt);
+
+/// Set the guard page bounds checking option.
+///
+/// In guard page bounds checking mode, the interpreter skips the explicit
+/// boundary checking of the loads and stores on the 32-bit memories, and
+/// traps the out-of-bound accesses by the faults in the guard region of the
+/// reserved memory. This option is ignored on the platforms without the guard
+/// region.
+///
+/// This function is thread-safe.
+///
+/// \param Cxt the WasmEdge_ConfigureContext to set the boolean value.
+/// \param IsGuardPageCheck the boolean value to determine to use the guard
+/// page bounds checking or not.
+WASMEDGE_CAPI_EXPORT extern void
+WasmEdge_ConfigureSetGuardPageCheck(WasmEdge_ConfigureContext *Cxt,
+                                    const bool IsGuardPageCheck);
+
+/// Get the guard page bounds checking option.
+///
+/// This function is thread-safe.
+///
+/// \param Cxt the WasmEdge_ConfigureContext to get the boolean value.
+///
+/// \returns the boolean value to determine to use the guard page bounds
+/// checking or not.
+WASMEDGE_CAPI_EXPORT extern bool
+WasmEdge_ConfigureIsGuardPageCheck(const WasmEdge_ConfigureContext *Cxt);
+
+/// Set the worker thread limit of the asynchronous executions.
+///
+/// The asynchronous executions run in the worker threads which are reused
+/// across the executions. When all of the worker threads are busy and the
+/// limit is reached, the executions are queued. The default value 0 means no
+/// limitation.
+///
+/// This function is thread-safe.
+///
+/// \param Cxt the WasmEdge_ConfigureContext to set the maximum thread count.
+/// \param Num the maximum worker thread count.
+WASMEDGE_CAPI_EXPORT extern void
+WasmEdge_ConfigureSetMaxThreads(WasmEdge_ConfigureContext *Cxt,
+                                const uint32_t Num);
+
+/// Get the setting of the worker thread limit of the asynchronous executions.
+///
+/// This function is thread-safe.
+///
+/// \param Cxt the WasmEdge_ConfigureContext to get the maximum thread count
+/// setting.
+///
+/// \returns the worker thread count limitation value.
+WASMEDGE_CAPI_EXPORT extern uint32_t
+WasmEdge_ConfigureGetMaxThreads(const WasmEdge_ConfigureContext *Cxt);
+
+/// Set the huge page mode of the memory instances.
+///
+/// The transparent huge page mode advises the kernel to back the memory pages
+/// with the transparent huge pages. The hugetlb mode backs the 2 MiB aligned
+/// chunks of the memory growth with the hugetlbfs pages, and falls back to the
+/// normal pages when no huge page is available. This option is ignored on the
+/// platforms without the support.
+///
+/// This function is thread-safe.
+///
+/// \param Cxt the WasmEdge_ConfigureContext to set the huge page mode.
+/// \param Mode the huge page mode.
+WASMEDGE_CAPI_EXPORT extern void
+WasmEdge_ConfigureSetHugePageMode(WasmEdge_ConfigureContext *Cxt,
+                                  const enum WasmEdge_MemoryHugePageMode Mode);
+
+/// Get the huge page mode of the memory instances.
+///
+/// This function is thread-safe.
+///
+/// \param Cxt the WasmEdge_ConfigureContext to get the huge page mode.
+///
+/// \returns the huge page mode.
+WASMEDGE_CAPI_EXPORT extern enum WasmEdge_MemoryHugePageMode
+WasmEdge_ConfigureGetHugePageMode(const WasmEdge_ConfigureContext *Cxt);
+
+/// Set the NUMA local memory option.
+///
+/// With this option, the pages of the memory instances prefer the NUMA node
+/// of the thread which instantiates or grows the memory.
+///
+/// This function is thread-safe.
+///
+/// \param Cxt the WasmEdge_ConfigureContext to set the boolean value.
+/// \param IsNUMALocalMemory the boolean value to determine to prefer the
+/// local NUMA node or not.
+WASMEDGE_CAPI_EXPORT extern void
+WasmEdge_ConfigureSetNUMALocalMemory(WasmEdge_ConfigureContext *Cxt,
+                                     const bool IsNUMALocalMemory);
+
+/// Get the NUMA local memory option.
+///
+/// This function is thread-safe.
+///
+/// \param Cxt the WasmEdge_ConfigureContext to get the boolean value.
+///
+/// \returns the boolean value to determine to prefer the local NUMA node or
+/// not.
+WASMEDGE_CAPI_EXPORT extern bool
+WasmEdge_ConfigureIsNUMALocalMemory(const WasmEdge_ConfigureContext *Cxt);
+
+/// Set the maximum idle slots of the process-wide memory slot pool.
+///
+/// The memory instances are allocated from the pool of the pre-reserved
+/// slots, and recycled into the pool when released. The default value 0 means
+/// no pooling.
+///
+/// This function is thread-safe.
+///
+/// \param Cxt the WasmEdge_ConfigureContext to set the slot count.
+/// \param Num the maximum idle slot count.
+WASMEDGE_CAPI_EXPORT extern void
+WasmEdge_ConfigureSetMemoryPoolSlots(WasmEdge_ConfigureContext *Cxt,
+                                     const uint32_t Num);
+
+/// Get the maximum idle slots of the process-wide memory slot pool.
+///
+/// This function is thread-safe.
+///
+/// \param Cxt the WasmEdge_ConfigureContext to get the slot count.
+///
+/// \returns the maximum idle slot count.
+WASMEDGE_CAPI_EXPORT extern uint32_t
+WasmEdge_ConfigureGetMemoryPoolSlots(const WasmEdge_ConfigureContext *Cxt);
+
+/// Set the page count kept committed in the recycled memory slots.
+///
+/// The kept pages are zeroed when the slot is reused instead of being faulted
+/// in again.
+///
+/// This function is thread-safe.
+///
+/// \param Cxt the WasmEdge_ConfigureContext to set the page count.
+/// \param Page the kept page count.
+WASMEDGE_CAPI_EXPORT extern void
+WasmEdge_ConfigureSetMemoryKeepResidentPages(WasmEdge_ConfigureContext *Cxt,
+                                             const uint32_t Page);
+
+/// Get the page count kept committed in the recycled memory slots.
+///
+/// This function is thread-safe.
+///
+/// \param Cxt the WasmEdge_ConfigureContext to get the page count.
+///
+/// \returns the kept page count.
+WASMEDGE_CAPI_EXPORT extern uint32_t
+WasmEdge_ConfigureGetMemoryKeepResidentPages(
+    const WasmEdge_ConfigureContext *Cxt);
+
+/// Set the growth mode of the committed pages of the memory instances.
+///
+/// The memory growth commits the pages in chunks instead of page by page to
+/// reduce the system calls. The memory size is not affected. The pages are
+/// still committed exactly for the AOT compiled modules and the guard page
+/// checked interpreter, which rely on the guard pages for the bound checking.
+///
+/// This function is thread-safe.
+///
+/// \param Cxt the WasmEdge_ConfigureContext to set the growth mode.
+/// \param Mode the growth mode.
+WASMEDGE_CAPI_EXPORT extern void WasmEdge_ConfigureSetMemoryGrowthMode(
+    WasmEdge_ConfigureContext *Cxt, const enum WasmEdge_MemoryGrowthMode Mode);
+
+/// Get the growth mode of the committed pages of the memory instances.
+///
+/// This function is thread-safe.
+///
+/// \param Cxt the WasmEdge_ConfigureContext to get the growth mode.
+///
+/// \returns the growth mode.
+WASMEDGE_CAPI_EXPORT extern enum WasmEdge_MemoryGrowthMode
+WasmEdge_ConfigureGetMemoryGrowthMode(const WasmEdge_ConfigureContext *Cxt);
+
+/// Set the growth step in pages of the committed pages.
+///
+/// This function is thread-safe.
+///
+/// \param Cxt the WasmEdge_ConfigureContext to set the growth step.
+/// \param Page the growth step in pages.
+WASMEDGE_CAPI_EXPORT extern void
+WasmEdge_ConfigureSetMemoryGrowthStepPages(WasmEdge_ConfigureContext *Cxt,
+                                           const uint32_t Page);
+
+/// Get the growth step in pages of the committed pages.
+///
+/// This function is thread-safe.
+///
+/// \param Cxt the WasmEdge_ConfigureContext to get the growth step.
+///
+/// \returns the growth step in pages.
+WASMEDGE_CAPI_EXPORT extern uint32_t
+WasmEdge_ConfigureGetMemoryGrowthStepPages(
+    const WasmEdge_ConfigureContext *Cxt);
+
 /// Set the option of enabling/disabling AF_UNIX support in the WASI socket.
 ///
 /// This function is thread-safe.
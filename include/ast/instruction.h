@@ -18,6 +18,7 @@
 #include "common/types.h"
 
 #include <algorithm>
+#include <cstring>
 #include <vector>
 
 namespace WasmEdge {
@@ -62,14 +63,9 @@ public:
 public:
   /// Constructor assigns the OpCode and the Offset.
   Instruction(OpCode Byte, uint32_t Off = 0) noexcept
-      : Offset(Off), Code(Byte) {
-#if defined(__x86_64__) || defined(__aarch64__) ||                             \
-    (defined(__riscv) && __riscv_xlen == 64)
-    Data.Num = static_cast<uint128_t>(0);
-#else
+      : Offset(Off), Code(static_cast<uint16_t>(Byte)) {
     Data.Num.Low = static_cast<uint64_t>(0);
     Data.Num.High = static_cast<uint64_t>(0);
-#endif
     Flags.IsAllocLabelList = false;
     Flags.IsAllocValTypeList = false;
     Flags.IsAllocBrCast = false;
@@ -118,7 +114,7 @@ public:
   }
 
   /// Getter of OpCode.
-  OpCode getOpCode() const noexcept { return Code; }
+  OpCode getOpCode() const noexcept { return static_cast<OpCode>(Code); }
 
   /// Getter of Offset.
   uint32_t getOffset() const noexcept { return Offset; }
@@ -216,11 +212,15 @@ public:
 
   /// Getter and setter of memory alignment.
   uint32_t getMemoryAlign() const noexcept { return Data.Memories.MemAlign; }
-  uint32_t &getMemoryAlign() noexcept { return Data.Memories.MemAlign; }
+  void setMemoryAlign(uint32_t Align) noexcept {
+    // The invalid alignments are saturated and rejected in validation.
+    Data.Memories.MemAlign =
+        static_cast<uint16_t>(std::min(Align, UINT32_C(0xFFFF)));
+  }
 
   /// Getter of memory offset.
-  uint32_t getMemoryOffset() const noexcept { return Data.Memories.MemOffset; }
-  uint32_t &getMemoryOffset() noexcept { return Data.Memories.MemOffset; }
+  uint64_t getMemoryOffset() const noexcept { return Data.Memories.MemOffset; }
+  uint64_t &getMemoryOffset() noexcept { return Data.Memories.MemOffset; }
 
   /// Getter of memory lane.
   uint8_t getMemoryLane() const noexcept { return Data.Memories.MemLane; }
@@ -235,21 +235,12 @@ public:
 
   /// Getter and setter of the constant value.
   ValVariant getNum() const noexcept {
-#if defined(__x86_64__) || defined(__aarch64__) ||                             \
-    (defined(__riscv) && __riscv_xlen == 64)
-    return ValVariant(Data.Num);
-#else
-    uint128_t N(Data.Num.High, Data.Num.Low);
+    uint128_t N;
+    std::memcpy(&N, &Data.Num, sizeof(uint128_t));
     return ValVariant(N);
-#endif
   }
   void setNum(ValVariant N) noexcept {
-#if defined(__x86_64__) || defined(__aarch64__) ||                             \
-    (defined(__riscv) && __riscv_xlen == 64)
-    Data.Num = N.get<uint128_t>();
-#else
     std::memcpy(&Data.Num, &N.get<uint128_t>(), sizeof(uint128_t));
-#endif
   }
 
   /// Getter and setter of BrCast info for Br_cast instructions.
@@ -328,23 +319,20 @@ private:
       uint32_t ValTypeListSize;
       ValType *ValTypeList;
     } SelectT;
-    // Type 7: TargetIdx, MemAlign, MemOffset, and MemLane.
+    // Type 7: TargetIdx, MemAlign, MemOffset, and MemLane. The offset is
+    // 64-bit for memory64 proposal.
     struct {
       uint32_t TargetIdx;
-      uint32_t MemAlign;
-      uint32_t MemOffset;
+      uint16_t MemAlign;
       uint8_t MemLane;
+      uint64_t MemOffset;
     } Memories;
-    // Type 8: Num.
-#if defined(__x86_64__) || defined(__aarch64__) ||                             \
-    (defined(__riscv) && __riscv_xlen == 64)
-    uint128_t Num;
-#else
+    // Type 8: Num. Stored as two 64-bit halves to keep the union 8-byte
+    // aligned, which shrinks the instruction node from 32 to 24 bytes.
     struct {
       uint64_t Low;
       uint64_t High;
     } Num;
-#endif
     // Type 9: End flags.
     struct {
       bool IsExprLast : 1;
@@ -361,7 +349,8 @@ private:
     CatchDescriptorLegacy CatchLegacy;
   } Data;
   uint32_t Offset = 0;
-  OpCode Code = OpCode::End;
+  // The dense OpCode enumeration is stored in 16 bits to pack the node.
+  uint16_t Code = static_cast<uint16_t>(OpCode::End);
   struct {
     bool IsAllocLabelList : 1;
     bool IsAllocValTypeList : 1;
@@ -371,6 +360,11 @@ private:
   /// @}
 };
 
+
+
+static_assert(sizeof(Instruction) <= 24,
+              "Instruction node is expected to be packed in 24 bytes");
+
 // Type aliasing
 using InstrVec = std::vector<Instruction>;
 using InstrView = Span<const Instruction>;
@@ -262,6 +262,10 @@ public:
   uint8_t getArchType() const noexcept { return ArchType; }
   void setArchType(uint8_t Type) noexcept { ArchType = Type; }
 
+  /// Getter and setter of CPU feature level.
+  uint8_t getTargetLevel() const noexcept { return TargetLevel; }
+  void setTargetLevel(uint8_t Level) noexcept { TargetLevel = Level; }
+
   /// Getter and setter of version address.
   uint64_t getVersionAddress() const noexcept { return VersionAddress; }
   void setVersionAddress(uint64_t Addr) noexcept { VersionAddress = Addr; }
@@ -294,6 +298,7 @@ private:
   uint32_t Version;
   uint8_t OSType;
   uint8_t ArchType;
+  uint8_t TargetLevel;
   uint64_t VersionAddress;
   uint64_t IntrinsicsAddress;
   std::vector<uintptr_t> TypesAddress;
@@ -16,7 +16,9 @@
 
 #include "ast/expression.h"
 #include "ast/type.h"
+#include "common/errcode.h"
 
+#include <functional>
 #include <vector>
 
 namespace WasmEdge {
@@ -116,12 +118,30 @@ public:
   const auto &getSymbol() const noexcept { return FuncSymbol; }
   void setSymbol(Symbol<void> S) noexcept { FuncSymbol = std::move(S); }
 
+  /// Lazy function body decoder. Set by the loader in lazy validation mode
+  /// instead of decoding the expression.
+  using LazyDecoder = std::function<Expect<InstrVec>()>;
+  /// Lazy function body checker. Set by the validator for the lazy function
+  /// body with the defined types of the module.
+  using LazyChecker =
+      std::function<Expect<void>(InstrView, Span<const SubType *const>)>;
+
+  /// Getter and setter of lazy function body decoder.
+  const LazyDecoder &getLazyDecoder() const noexcept { return Decoder; }
+  void setLazyDecoder(LazyDecoder D) noexcept { Decoder = std::move(D); }
+
+  /// Getter and setter of lazy function body checker.
+  const LazyChecker &getLazyChecker() const noexcept { return Checker; }
+  void setLazyChecker(LazyChecker C) noexcept { Checker = std::move(C); }
+
 private:
   /// \name Data of CodeSegment node.
   /// @{
   uint32_t SegSize = 0;
   std::vector<std::pair<uint32_t, ValType>> Locals;
   Symbol<void> FuncSymbol;
+  LazyDecoder Decoder;
+  LazyChecker Checker;
   /// @}
 };
 
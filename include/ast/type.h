@@ -56,6 +56,11 @@ public:
   bool isShared() const noexcept { return Type == LimitType::Shared; }
   void setType(LimitType TargetType) noexcept { Type = TargetType; }
 
+  /// Getter and setter of the 64-bit address type in memory64 proposal. The
+  /// min and max values are still the page counts in 32-bit.
+  bool is64() const noexcept { return Is64; }
+  void set64(bool Val) noexcept { Is64 = Val; }
+
   /// Getter and setter of min value.
   uint32_t getMin() const noexcept { return Min; }
   void setMin(uint32_t Val) noexcept { Min = Val; }
@@ -68,6 +73,7 @@ private:
   /// \name Data of Limit.
   /// @{
   LimitType Type;
+  bool Is64 = false;
   uint32_t Min;
   uint32_t Max;
   /// @}
@@ -215,7 +221,7 @@ public:
   SubType() noexcept = default;
   SubType(const FunctionType &FT) noexcept
       : IsFinal(true), CompType(FT), RecTypeInfo(std::nullopt),
-        TypeIndex(std::nullopt) {}
+        TypeIndex(std::nullopt), CanonicalID(std::nullopt) {}
 
   /// Getter and setter of final flag.
   bool isFinal() const noexcept { return IsFinal; }
@@ -251,6 +257,12 @@ public:
   std::optional<uint32_t> getTypeIndex() const noexcept { return TypeIndex; }
   void setTypeIndex(uint32_t Index) noexcept { TypeIndex = Index; }
 
+  /// Getter of canonical type ID. Equivalent defined types share the same ID.
+  std::optional<uint32_t> getCanonicalID() const noexcept {
+    return CanonicalID;
+  }
+  void setCanonicalID(uint32_t ID) noexcept { CanonicalID = ID; }
+
 private:
   /// \name Data of CompositeType.
   /// @{
@@ -268,6 +280,8 @@ private:
   std::optional<RecInfo> RecTypeInfo;
   /// Type index in the module. Record for backward iteration.
   std::optional<uint32_t> TypeIndex;
+  /// Canonical type ID assigned at instantiation. Record for fast matching.
+  std::optional<uint32_t> CanonicalID;
   /// @}
 };
 
@@ -442,6 +456,12 @@ private:
     }
     const auto *LHSType = LHSList[LHSIdx];
     const auto *RHSType = RHSList[RHSIdx];
+    if (LHSType->getCanonicalID().has_value() &&
+        RHSType->getCanonicalID().has_value()) {
+      // Both defined types are canonicalized. The equivalent defined types
+      // share the same canonical ID.
+      return *LHSType->getCanonicalID() == *RHSType->getCanonicalID();
+    }
     // For GC proposal, a single subtype can be seemed as a self-recursive type.
     // That is, `(rec (type $t1 (func (param (ref $t1)))))` and
     //               `(type $t1 (func (param (ref $t1))))` are the same.
@@ -14,8 +14,10 @@
 #pragma once
 
 #include "errcode.h"
+#include "threadpool.h"
 
 #include <future>
+#include <memory>
 #include <thread>
 
 namespace WasmEdge {
@@ -37,6 +39,18 @@ public:
         });
     Thread.detach();
   }
+  template <typename Inst, typename... FArgsT, typename... ArgsT>
+  Async(ThreadPool &Pool, T (Inst::*FPtr)(FArgsT...), Inst &TargetInst,
+        ArgsT &&...Args)
+      : StopFunc([&TargetInst]() { TargetInst.stop(); }) {
+    auto Promise = std::make_shared<std::promise<T>>();
+    Future = Promise->get_future();
+    Pool.submit([FPtr, P = std::move(Promise),
+                 Tuple = std::tuple(&TargetInst,
+                                    std::forward<ArgsT>(Args)...)]() mutable {
+      P->set_value(std::apply(FPtr, Tuple));
+    });
+  }
   Async(const Async &) noexcept = delete;
   Async(Async &&Other) noexcept : Async() { swap(*this, Other); }
   Async &operator=(const Async &) = delete;
@@ -37,7 +37,10 @@ public:
         OFormat(RHS.OFormat.load(std::memory_order_relaxed)),
         DumpIR(RHS.DumpIR.load(std::memory_order_relaxed)),
         GenericBinary(RHS.GenericBinary.load(std::memory_order_relaxed)),
-        Interruptible(RHS.Interruptible.load(std::memory_order_relaxed)) {}
+        FatBinary(RHS.FatBinary.load(std::memory_order_relaxed)),
+        Interruptible(RHS.Interruptible.load(std::memory_order_relaxed)),
+        CompileThreadNum(
+            RHS.CompileThreadNum.load(std::memory_order_relaxed)) {}
 
   /// AOT compiler optimization level enum class.
   enum class OptimizationLevel : uint8_t {
@@ -93,6 +96,17 @@ public:
     return GenericBinary.load(std::memory_order_relaxed);
   }
 
+  /// Fat universal WASM output. The AOT code is compiled for each CPU feature
+  /// level of the architecture, and the loader selects the highest level
+  /// supported by the host. Only for the universal WASM output format.
+  void setFatBinary(bool IsFatBinary) noexcept {
+    FatBinary.store(IsFatBinary, std::memory_order_relaxed);
+  }
+
+  bool isFatBinary() const noexcept {
+    return FatBinary.load(std::memory_order_relaxed);
+  }
+
   void setInterruptible(bool IsInterruptible) noexcept {
     Interruptible.store(IsInterruptible, std::memory_order_relaxed);
   }
@@ -101,12 +115,24 @@ public:
     return Interruptible.load(std::memory_order_relaxed);
   }
 
+  /// Worker threads of compiling the function partitions. 0 means the
+  /// hardware concurrency. The compiled output does not depend on this value.
+  void setCompileThreadNum(uint32_t Num) noexcept {
+    CompileThreadNum.store(Num, std::memory_order_relaxed);
+  }
+
+  uint32_t getCompileThreadNum() const noexcept {
+    return CompileThreadNum.load(std::memory_order_relaxed);
+  }
+
 private:
   std::atomic<OptimizationLevel> OptLevel = OptimizationLevel::O3;
   std::atomic<OutputFormat> OFormat = OutputFormat::Wasm;
   std::atomic<bool> DumpIR = false;
   std::atomic<bool> GenericBinary = false;
+  std::atomic<bool> FatBinary = false;
   std::atomic<bool> Interruptible = false;
+  std::atomic<uint32_t> CompileThreadNum = 0;
 };
 
 class RuntimeConfigure {
@@ -115,8 +141,25 @@ public:
   RuntimeConfigure(const RuntimeConfigure &RHS) noexcept
       : MaxMemPage(RHS.MaxMemPage.load(std::memory_order_relaxed)),
         EnableJIT(RHS.EnableJIT.load(std::memory_order_relaxed)),
+        EnableTieredJIT(RHS.EnableTieredJIT.load(std::memory_order_relaxed)),
+        TierUpThreshold(RHS.TierUpThreshold.load(std::memory_order_relaxed)),
+        EnableLazyJIT(RHS.EnableLazyJIT.load(std::memory_order_relaxed)),
+        EnableAOTCache(RHS.EnableAOTCache.load(std::memory_order_relaxed)),
+        AOTCacheSizeLimit(
+            RHS.AOTCacheSizeLimit.load(std::memory_order_relaxed)),
         ForceInterpreter(RHS.ForceInterpreter.load(std::memory_order_relaxed)),
-        AllowAFUNIX(RHS.AllowAFUNIX.load(std::memory_order_relaxed)) {}
+        AllowAFUNIX(RHS.AllowAFUNIX.load(std::memory_order_relaxed)),
+        LazyValidation(RHS.LazyValidation.load(std::memory_order_relaxed)),
+        GuardPageCheck(RHS.GuardPageCheck.load(std::memory_order_relaxed)),
+        MaxThreads(RHS.MaxThreads.load(std::memory_order_relaxed)),
+        HugePage(RHS.HugePage.load(std::memory_order_relaxed)),
+        NUMALocalMemory(RHS.NUMALocalMemory.load(std::memory_order_relaxed)),
+        MemoryPoolSlots(RHS.MemoryPoolSlots.load(std::memory_order_relaxed)),
+        MemoryKeepResidentPages(
+            RHS.MemoryKeepResidentPages.load(std::memory_order_relaxed)),
+        MemoryGrowth(RHS.MemoryGrowth.load(std::memory_order_relaxed)),
+        MemoryGrowthStepPages(
+            RHS.MemoryGrowthStepPages.load(std::memory_order_relaxed)) {}
 
   void setMaxMemoryPage(const uint32_t Page) noexcept {
     MaxMemPage.store(Page, std::memory_order_relaxed);
@@ -134,6 +177,58 @@ public:
     return EnableJIT.load(std::memory_order_relaxed);
   }
 
+  /// Tiered execution for the JIT mode. The functions start in the
+  /// interpreter, and are compiled in the background after being hot.
+  void setEnableTieredJIT(bool IsEnableTieredJIT) noexcept {
+    EnableTieredJIT.store(IsEnableTieredJIT, std::memory_order_relaxed);
+  }
+
+  bool isEnableTieredJIT() const noexcept {
+    return EnableTieredJIT.load(std::memory_order_relaxed);
+  }
+
+  /// Count of the calls and the loop back edges for a function to be hot in
+  /// the tiered execution.
+  void setTierUpThreshold(const uint32_t Count) noexcept {
+    TierUpThreshold.store(Count, std::memory_order_relaxed);
+  }
+
+  uint32_t getTierUpThreshold() const noexcept {
+    return TierUpThreshold.load(std::memory_order_relaxed);
+  }
+
+  /// Lazy compilation for the JIT mode. The functions are compiled one by one
+  /// on their first calls instead of compiling the whole module before the
+  /// instantiation.
+  void setEnableLazyJIT(bool IsEnableLazyJIT) noexcept {
+    EnableLazyJIT.store(IsEnableLazyJIT, std::memory_order_relaxed);
+  }
+
+  bool isEnableLazyJIT() const noexcept {
+    return EnableLazyJIT.load(std::memory_order_relaxed);
+  }
+
+  /// On-disk cache of the compiled modules in loading. The WASM modules are
+  /// compiled once for the compiler options and the host, and the later loads
+  /// of them reuse the compiled code.
+  void setEnableAOTCache(bool IsEnableAOTCache) noexcept {
+    EnableAOTCache.store(IsEnableAOTCache, std::memory_order_relaxed);
+  }
+
+  bool isEnableAOTCache() const noexcept {
+    return EnableAOTCache.load(std::memory_order_relaxed);
+  }
+
+  /// Total size in bytes of the cached compiled modules. The least recently
+  /// used ones are removed over the limit. 0 for no limitation.
+  void setAOTCacheSizeLimit(const uint64_t Size) noexcept {
+    AOTCacheSizeLimit.store(Size, std::memory_order_relaxed);
+  }
+
+  uint64_t getAOTCacheSizeLimit() const noexcept {
+    return AOTCacheSizeLimit.load(std::memory_order_relaxed);
+  }
+
   void setForceInterpreter(bool IsForceInterpreter) noexcept {
     ForceInterpreter.store(IsForceInterpreter, std::memory_order_relaxed);
   }
@@ -150,11 +245,133 @@ public:
     return AllowAFUNIX.load(std::memory_order_relaxed);
   }
 
+  /// Lazy validation mode for the interpreter. The function bodies are kept as
+  /// raw bytes in loading, and decoded and validated at their first calls.
+  void setLazyValidation(bool IsLazyValidation) noexcept {
+    LazyValidation.store(IsLazyValidation, std::memory_order_relaxed);
+  }
+
+  bool isLazyValidation() const noexcept {
+    return LazyValidation.load(std::memory_order_relaxed);
+  }
+
+  /// Guard page bounds checking for the interpreter. The loads and stores of
+  /// the 32-bit memories skip the explicit boundary checking and trap by the
+  /// faults in the guard region of the reserved memory.
+  void setGuardPageCheck(bool IsGuardPageCheck) noexcept {
+    GuardPageCheck.store(IsGuardPageCheck, std::memory_order_relaxed);
+  }
+
+  bool isGuardPageCheck() const noexcept {
+    return GuardPageCheck.load(std::memory_order_relaxed);
+  }
+
+  /// Maximum worker thread count of the asynchronous executions. The worker
+  /// threads are reused across the executions. 0 for no limitation.
+  void setMaxThreads(const uint32_t Num) noexcept {
+    MaxThreads.store(Num, std::memory_order_relaxed);
+  }
+
+  uint32_t getMaxThreads() const noexcept {
+    return MaxThreads.load(std::memory_order_relaxed);
+  }
+
+  /// Huge page mode of the memory instances.
+  enum class HugePageMode : uint8_t {
+    /// Normal pages.
+    None,
+    /// Transparent huge pages by madvise.
+    Transparent,
+    /// Hugetlbfs pages for the 2 MiB aligned chunks.
+    HugeTLB,
+  };
+
+  void setHugePageMode(HugePageMode Mode) noexcept {
+    HugePage.store(Mode, std::memory_order_relaxed);
+  }
+
+  HugePageMode getHugePageMode() const noexcept {
+    return HugePage.load(std::memory_order_relaxed);
+  }
+
+  /// Prefer the NUMA node of the instantiating or growing thread for the
+  /// pages of the memory instances.
+  void setNUMALocalMemory(bool IsNUMALocalMemory) noexcept {
+    NUMALocalMemory.store(IsNUMALocalMemory, std::memory_order_relaxed);
+  }
+
+  bool isNUMALocalMemory() const noexcept {
+    return NUMALocalMemory.load(std::memory_order_relaxed);
+  }
+
+  /// Maximum idle slots of the process-wide memory slot pool. The memory
+  /// instances are allocated from and recycled into the pool. 0 for no
+  /// pooling.
+  void setMemoryPoolSlots(const uint32_t Num) noexcept {
+    MemoryPoolSlots.store(Num, std::memory_order_relaxed);
+  }
+
+  uint32_t getMemoryPoolSlots() const noexcept {
+    return MemoryPoolSlots.load(std::memory_order_relaxed);
+  }
+
+  /// Pages kept committed in the recycled memory slots.
+  void setMemoryKeepResidentPages(const uint32_t Page) noexcept {
+    MemoryKeepResidentPages.store(Page, std::memory_order_relaxed);
+  }
+
+  uint32_t getMemoryKeepResidentPages() const noexcept {
+    return MemoryKeepResidentPages.load(std::memory_order_relaxed);
+  }
+
+  /// Growth mode of the committed pages of the memory instances. The memory
+  /// size is not affected. The memory pages are committed exactly for the
+  /// compiled modules and the guard page checked interpreter.
+  enum class MemoryGrowthMode : uint8_t {
+    /// Commit the grown pages exactly.
+    Exact,
+    /// Commit up to the next multiple of the growth step.
+    Fixed,
+    /// Commit at least double the committed pages.
+    Geometric,
+  };
+
+  void setMemoryGrowthMode(MemoryGrowthMode Mode) noexcept {
+    MemoryGrowth.store(Mode, std::memory_order_relaxed);
+  }
+
+  MemoryGrowthMode getMemoryGrowthMode() const noexcept {
+    return MemoryGrowth.load(std::memory_order_relaxed);
+  }
+
+  /// Growth step in pages of the committed pages.
+  void setMemoryGrowthStepPages(const uint32_t Page) noexcept {
+    MemoryGrowthStepPages.store(Page, std::memory_order_relaxed);
+  }
+
+  uint32_t getMemoryGrowthStepPages() const noexcept {
+    return MemoryGrowthStepPages.load(std::memory_order_relaxed);
+  }
+
 private:
   std::atomic<uint32_t> MaxMemPage = 65536;
   std::atomic<bool> EnableJIT = false;
+  std::atomic<bool> EnableTieredJIT = false;
+  std::atomic<uint32_t> TierUpThreshold = 1000;
+  std::atomic<bool> EnableLazyJIT = false;
+  std::atomic<bool> EnableAOTCache = false;
+  std::atomic<uint64_t> AOTCacheSizeLimit = UINT64_C(1) << 30;
   std::atomic<bool> ForceInterpreter = false;
   std::atomic<bool> AllowAFUNIX = false;
+  std::atomic<bool> LazyValidation = false;
+  std::atomic<bool> GuardPageCheck = false;
+  std::atomic<uint32_t> MaxThreads = 0;
+  std::atomic<HugePageMode> HugePage = HugePageMode::None;
+  std::atomic<bool> NUMALocalMemory = false;
+  std::atomic<uint32_t> MemoryPoolSlots = 0;
+  std::atomic<uint32_t> MemoryKeepResidentPages = 0;
+  std::atomic<MemoryGrowthMode> MemoryGrowth = MemoryGrowthMode::Exact;
+  std::atomic<uint32_t> MemoryGrowthStepPages = 16;
 };
 
 class StatisticsConfigure {
@@ -164,7 +381,8 @@ public:
       : InstrCounting(RHS.InstrCounting.load(std::memory_order_relaxed)),
         CostMeasuring(RHS.CostMeasuring.load(std::memory_order_relaxed)),
         TimeMeasuring(RHS.TimeMeasuring.load(std::memory_order_relaxed)), 
-        SnapShotting(RHS.SnapShotting.load(std::memory_order_relaxed)) {}
+        SnapShotting(RHS.SnapShotting.load(std::memory_order_relaxed)),
+        Profiling(RHS.Profiling.load(std::memory_order_relaxed)) {}
         // 如果出现了新的参数，拷贝构造函数需要追加修改
 
   void setInstructionCounting(bool IsCount) noexcept {
@@ -199,6 +417,16 @@ public:
     SnapShotting.store(IsSnapShot, std::memory_order_relaxed);
   }
 
+  /// Count the function entries and the conditional branches in the
+  /// interpreter for the profile-guided compilation.
+  void setProfiling(bool IsProfiling) noexcept {
+    Profiling.store(IsProfiling, std::memory_order_relaxed);
+  }
+
+  bool isProfiling() const noexcept {
+    return Profiling.load(std::memory_order_relaxed);
+  }
+
   void setCostLimit(uint64_t Cost) noexcept {
     CostLimit.store(Cost, std::memory_order_relaxed);
   }
@@ -212,6 +440,7 @@ private:
   std::atomic<bool> CostMeasuring = false;
   std::atomic<bool> TimeMeasuring = false;
   std::atomic<bool> SnapShotting = false;
+  std::atomic<bool> Profiling = false;
 
   std::atomic<uint64_t> CostLimit = std::numeric_limits<uint64_t>::max();
 };
@@ -59,4 +59,23 @@ enum WasmEdge_CompilerOutputFormat {
   WasmEdge_CompilerOutputFormat_Wasm
 };
 
+enum WasmEdge_MemoryHugePageMode {
+  // Normal pages.
+  WasmEdge_MemoryHugePageMode_None = 0,
+  // Transparent huge pages by madvise.
+  WasmEdge_MemoryHugePageMode_Transparent,
+  // Hugetlbfs pages for the 2 MiB aligned chunks.
+  WasmEdge_MemoryHugePageMode_HugeTLB
+};
+
+/// Memory growth mode C enumeration.
+enum WasmEdge_MemoryGrowthMode {
+  // Commit the grown pages exactly.
+  WasmEdge_MemoryGrowthMode_Exact = 0,
+  // Commit up to the next multiple of the growth step.
+  WasmEdge_MemoryGrowthMode_Fixed,
+  // Commit at least double the committed pages.
+  WasmEdge_MemoryGrowthMode_Geometric
+};
+
 #endif // WASMEDGE_C_API_ENUM_CONFIGURE_H
@@ -0,0 +1,63 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2019-2022 Second State INC
+
+//===-- wasmedge/common/epoch.h - Epoch counter definition ----------------===//
+//
+// Part of the WasmEdge Project.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file contents the process-wide epoch counter for the interruption of
+/// the executions.
+///
+//===----------------------------------------------------------------------===//
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace WasmEdge {
+
+/// Process-wide epoch counter. The epoch is the count of the ticks elapsed
+/// since the process starts, and is advanced by a single timer thread while
+/// any user acquires it. The executions compare the epoch with their deadline
+/// epochs by plain loads, so the interruption needs no atomic read-modify-write
+/// in the executions.
+class Epoch {
+public:
+  using Clock = std::chrono::steady_clock;
+  static inline constexpr const std::chrono::milliseconds kTick{1};
+
+  /// Getter of the current epoch. Never ahead of the time.
+  static uint64_t load() noexcept {
+    return Counter.load(std::memory_order_relaxed);
+  }
+  static std::atomic_uint64_t &getCounter() noexcept { return Counter; }
+
+  /// Convert the time point to the epoch reached at it.
+  template <typename CT, typename DT>
+  static uint64_t
+  toEpoch(const std::chrono::time_point<CT, DT> &Time) noexcept {
+    const auto Elapsed = Clock::now() + (Time - CT::now()) - getStart();
+    if (Elapsed <= Clock::duration::zero()) {
+      return 0;
+    }
+    return static_cast<uint64_t>((Elapsed + kTick - Clock::duration(1)) /
+                                 kTick);
+  }
+
+  /// Start advancing the epoch. Each acquire() should be paired with a
+  /// release().
+  static void acquire();
+  /// Stop advancing the epoch when no user acquires it.
+  static void release() noexcept;
+
+private:
+  static Clock::time_point getStart() noexcept;
+
+  static std::atomic_uint64_t Counter;
+};
+
+} // namespace WasmEdge
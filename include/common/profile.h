@@ -0,0 +1,75 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2019-2022 Second State INC
+
+//===-- wasmedge/common/profile.h - Execution profile definition ----------===//
+//
+// Part of the WasmEdge Project.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file contents the execution profile of a module for the profile-guided
+/// compilation.
+///
+//===----------------------------------------------------------------------===//
+#pragma once
+
+#include "common/errcode.h"
+#include "common/filesystem.h"
+
+#include <cstdint>
+#include <map>
+
+namespace WasmEdge {
+
+/// Execution counts of a module collected in the profiling runs. The
+/// functions are keyed by the indices in the function index space, and the
+/// conditional branches by the bytecode offsets of the `if` and `br_if`
+/// instructions.
+class Profile {
+public:
+  struct BranchCount {
+    /// Count of the non-zero conditions, which enter the `if` block or take
+    /// the `br_if` branch.
+    uint64_t Taken = 0;
+    uint64_t NotTaken = 0;
+  };
+
+  void addFunctionCount(uint32_t Index, uint64_t Count) {
+    Functions[Index] += Count;
+  }
+  void addBranchCount(uint32_t Offset, const BranchCount &Count) {
+    auto &Branch = Branches[Offset];
+    Branch.Taken += Count.Taken;
+    Branch.NotTaken += Count.NotTaken;
+  }
+
+  /// Getter of the entry count of the function. 0 for not executed.
+  uint64_t getFunctionCount(uint32_t Index) const noexcept {
+    const auto It = Functions.find(Index);
+    return It != Functions.end() ? It->second : 0;
+  }
+  /// Getter of the counts of the branch. Nullptr for not executed.
+  const BranchCount *getBranchCount(uint32_t Offset) const noexcept {
+    const auto It = Branches.find(Offset);
+    return It != Branches.end() ? &It->second : nullptr;
+  }
+
+  const std::map<uint32_t, uint64_t> &getFunctions() const noexcept {
+    return Functions;
+  }
+  const std::map<uint32_t, BranchCount> &getBranches() const noexcept {
+    return Branches;
+  }
+
+  /// Write the profile into the file in text format.
+  Expect<void> save(const std::filesystem::path &Path) const;
+  /// Read the profile from the file.
+  static Expect<Profile> load(const std::filesystem::path &Path);
+
+private:
+  std::map<uint32_t, uint64_t> Functions;
+  std::map<uint32_t, BranchCount> Branches;
+};
+
+} // namespace WasmEdge
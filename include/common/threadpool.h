@@ -0,0 +1,99 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2019-2022 Second State INC
+
+//===-- wasmedge/common/threadpool.h - Thread pool class definition -------===//
+//
+// Part of the WasmEdge Project.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file is the definition class of ThreadPool class.
+///
+//===----------------------------------------------------------------------===//
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace WasmEdge {
+
+/// Worker pool for the asynchronous executions.
+///
+/// The worker threads are created on demand and reused after their tasks are
+/// done. A new worker is created only when no worker is idle and the worker
+/// count does not reach the limit. When the limit is reached, the tasks are
+/// queued until a worker is free. The limit 0 means no limitation.
+class ThreadPool {
+public:
+  explicit ThreadPool(uint32_t MaxThreads = 0) noexcept
+      : MaxThreads(MaxThreads) {}
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+  ~ThreadPool() noexcept {
+    {
+      std::unique_lock<std::mutex> Lock(Mutex);
+      Stopped = true;
+    }
+    Cond.notify_all();
+    for (auto &Worker : Workers) {
+      Worker.join();
+    }
+  }
+
+  /// Getter of the maximum worker count.
+  uint32_t getMaxThreads() const noexcept { return MaxThreads; }
+
+  /// Getter of the created worker count.
+  uint32_t getThreadNum() const noexcept {
+    std::unique_lock<std::mutex> Lock(Mutex);
+    return static_cast<uint32_t>(Workers.size());
+  }
+
+  /// Submit a task to run in a worker thread.
+  void submit(std::function<void()> Task) {
+    std::unique_lock<std::mutex> Lock(Mutex);
+    Tasks.push_back(std::move(Task));
+    if (Idle < Tasks.size() &&
+        (MaxThreads == 0 || Workers.size() < MaxThreads)) {
+      Workers.emplace_back([this]() { work(); });
+    } else {
+      Cond.notify_one();
+    }
+  }
+
+private:
+  void work() noexcept {
+    std::unique_lock<std::mutex> Lock(Mutex);
+    while (true) {
+      Idle++;
+      Cond.wait(Lock, [this]() { return Stopped || !Tasks.empty(); });
+      Idle--;
+      if (Tasks.empty()) {
+        // Stopped and no pending tasks.
+        return;
+      }
+      auto Task = std::move(Tasks.front());
+      Tasks.pop_front();
+      Lock.unlock();
+      Task();
+      Lock.lock();
+    }
+  }
+
+  const uint32_t MaxThreads;
+  mutable std::mutex Mutex;
+  std::condition_variable Cond;
+  std::deque<std::function<void()>> Tasks;
+  std::vector<std::thread> Workers;
+  size_t Idle = 0;
+  bool Stopped = false;
+};
+
+} // namespace WasmEdge
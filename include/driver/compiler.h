@@ -25,6 +25,8 @@ struct DriverCompilerOptions {
       : WasmName(PO::Description("Wasm file"sv), PO::MetaVar("WASM"sv)),
         SoName(PO::Description("Wasm so file"sv), PO::MetaVar("WASM_SO"sv)),
         ConfGenericBinary(PO::Description("Generate a generic binary"sv)),
+        ConfFatBinary(PO::Description(
+            "Generate a universal WASM with the code of each CPU feature level, selected by the host CPU in loading."sv)),
         ConfDumpIR(
             PO::Description("Dump LLVM IR to `wasm.ll` and `wasm-opt.ll`."sv)),
         ConfInterruptible(PO::Description("Generate a interruptible binary"sv)),
@@ -59,11 +61,20 @@ struct DriverCompilerOptions {
         PropAll(PO::Description("Enable all features"sv)),
         PropOptimizationLevel(
             PO::Description("Optimization level, one of 0, 1, 2, 3, s, z."sv),
-            PO::DefaultValue(std::string("2"))) {}
+            PO::DefaultValue(std::string("2"))),
+        ConfCompileThreadNum(
+            PO::Description(
+                "Worker threads of the compilation, default value is 0 for the hardware concurrency"sv),
+            PO::MetaVar("JOBS"sv), PO::DefaultValue<uint32_t>(0)),
+        ProfileUse(
+            PO::Description(
+                "Optimize with the execution counts in the profile file written by `wasmedge --profile-generate`."sv),
+            PO::MetaVar("PROFILE"sv)) {}
 
   PO::Option<std::string> WasmName;
   PO::Option<std::string> SoName;
   PO::Option<PO::Toggle> ConfGenericBinary;
+  PO::Option<PO::Toggle> ConfFatBinary;
   PO::Option<PO::Toggle> ConfDumpIR;
   PO::Option<PO::Toggle> ConfInterruptible;
   PO::Option<PO::Toggle> ConfEnableInstructionCounting;
@@ -85,6 +96,8 @@ struct DriverCompilerOptions {
   PO::Option<PO::Toggle> PropRelaxedSIMD;
   PO::Option<PO::Toggle> PropAll;
   PO::Option<std::string> PropOptimizationLevel;
+  PO::Option<uint32_t> ConfCompileThreadNum;
+  PO::List<std::string> ProfileUse;
 
   void add_option(PO::ArgumentParser &Parser) noexcept {
     Parser.add_option(WasmName)
@@ -96,6 +109,7 @@ struct DriverCompilerOptions {
         .add_option("enable-time-measuring"sv, ConfEnableTimeMeasuring)
         .add_option("enable-all-statistics"sv, ConfEnableAllStatistics)
         .add_option("generic-binary"sv, ConfGenericBinary)
+        .add_option("fat-binary"sv, ConfFatBinary)
         .add_option("disable-import-export-mut-globals"sv, PropMutGlobals)
         .add_option("disable-non-trap-float-to-int"sv, PropNonTrapF2IConvs)
         .add_option("disable-sign-extension-operators"sv, PropSignExtendOps)
@@ -110,7 +124,9 @@ struct DriverCompilerOptions {
         .add_option("enable-threads"sv, PropThreads)
         .add_option("enable-relaxed-simd"sv, PropRelaxedSIMD)
         .add_option("enable-all"sv, PropAll)
-        .add_option("optimize"sv, PropOptimizationLevel);
+        .add_option("optimize"sv, PropOptimizationLevel)
+        .add_option("jobs"sv, ConfCompileThreadNum)
+        .add_option("profile-use"sv, ProfileUse);
   }
 };
 
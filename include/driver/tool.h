@@ -62,6 +62,7 @@ struct DriverToolOptions {
             PO::Description("Enable Function Reference proposal"sv)),
         PropGC(PO::Description("Enable GC proposal, this is experimental"sv)),
         PropMultiMem(PO::Description("Enable Multiple memories proposal"sv)),
+        PropMemory64(PO::Description("Enable Memory64 proposal"sv)),
         PropThreads(PO::Description("Enable Threads proposal"sv)),
         PropRelaxedSIMD(PO::Description("Enable Relaxed SIMD proposal"sv)),
         PropExceptionHandling(
@@ -79,8 +80,16 @@ struct DriverToolOptions {
             "Enable generating code for all statistics options include instruction counting, gas measuring, and execution time"sv)),
         ConfEnableJIT(
             PO::Description("Enable Just-In-Time compiler for running WASM"sv)),
+        ConfEnableTieredJIT(PO::Description(
+            "Start running WASM in interpreter mode, and compile the hot functions by Just-In-Time compiler in background."sv)),
+        ConfEnableLazyJIT(PO::Description(
+            "Compile each WASM function by Just-In-Time compiler on its first call."sv)),
+        ConfEnableAOTCache(PO::Description(
+            "Compile WASM modules once and reuse the compiled code in the on-disk cache."sv)),
         ConfForceInterpreter(
             PO::Description("Forcibly run WASM in interpreter mode."sv)),
+        ConfGuardPageCheck(PO::Description(
+            "Trap the out-of-bound memory accesses in interpreter mode by the guard pages instead of the explicit boundary checking."sv)),
         TimeLim(
             PO::Description(
                 "Limitation of maximum time(in milliseconds) for execution, default value is 0 for no limitations"sv),
@@ -94,7 +103,11 @@ struct DriverToolOptions {
                 "Limitation of pages(as size of 64 KiB) in every memory instance. Upper bound can be specified as --memory-page-limit `PAGE_COUNT`."sv),
             PO::MetaVar("PAGE_COUNT"sv)),
         ForbiddenPlugins(PO::Description("List of plugins to ignore."sv),
-                         PO::MetaVar("NAMES"sv)) {}
+                         PO::MetaVar("NAMES"sv)),
+        ProfileGenerate(
+            PO::Description(
+                "Run WASM in interpreter mode, and write the execution counts of the functions and the branches into the profile file for the profile-guided compilation."sv),
+            PO::MetaVar("PROFILE"sv)) {}
 
   PO::Option<std::string> SoName;
   PO::List<std::string> Args;
@@ -114,6 +127,7 @@ struct DriverToolOptions {
   PO::Option<PO::Toggle> PropFunctionReference;
   PO::Option<PO::Toggle> PropGC;
   PO::Option<PO::Toggle> PropMultiMem;
+  PO::Option<PO::Toggle> PropMemory64;
   PO::Option<PO::Toggle> PropThreads;
   PO::Option<PO::Toggle> PropRelaxedSIMD;
   PO::Option<PO::Toggle> PropExceptionHandling;
@@ -124,11 +138,16 @@ struct DriverToolOptions {
   PO::Option<PO::Toggle> ConfEnableTimeMeasuring;
   PO::Option<PO::Toggle> ConfEnableAllStatistics;
   PO::Option<PO::Toggle> ConfEnableJIT;
+  PO::Option<PO::Toggle> ConfEnableTieredJIT;
+  PO::Option<PO::Toggle> ConfEnableLazyJIT;
+  PO::Option<PO::Toggle> ConfEnableAOTCache;
   PO::Option<PO::Toggle> ConfForceInterpreter;
+  PO::Option<PO::Toggle> ConfGuardPageCheck;
   PO::Option<uint64_t> TimeLim;
   PO::List<int> GasLim;
   PO::List<int> MemLim;
   PO::List<std::string> ForbiddenPlugins;
+  PO::List<std::string> ProfileGenerate;
   PO::Option<PO::Toggle> ConfEnableSnapshotting;
   PO::List<std::string> SnapshotInputDir;
   PO::List<std::string> SnapshotOutputDir;
@@ -148,7 +167,11 @@ struct DriverToolOptions {
         .add_option("enable-time-measuring"sv, ConfEnableTimeMeasuring)
         .add_option("enable-all-statistics"sv, ConfEnableAllStatistics)
         .add_option("enable-jit"sv, ConfEnableJIT)
+        .add_option("enable-tiered-jit"sv, ConfEnableTieredJIT)
+        .add_option("enable-lazy-jit"sv, ConfEnableLazyJIT)
+        .add_option("enable-aot-cache"sv, ConfEnableAOTCache)
         .add_option("force-interpreter"sv, ConfForceInterpreter)
+        .add_option("guard-page-check"sv, ConfGuardPageCheck)
         .add_option("disable-import-export-mut-globals"sv, PropMutGlobals)
         .add_option("disable-non-trap-float-to-int"sv, PropNonTrapF2IConvs)
         .add_option("disable-sign-extension-operators"sv, PropSignExtendOps)
@@ -162,6 +185,7 @@ struct DriverToolOptions {
         .add_option("enable-function-reference"sv, PropFunctionReference)
         .add_option("enable-gc"sv, PropGC)
         .add_option("enable-multi-memory"sv, PropMultiMem)
+        .add_option("enable-memory64"sv, PropMemory64)
         .add_option("enable-threads"sv, PropThreads)
         .add_option("enable-relaxed-simd"sv, PropRelaxedSIMD)
         .add_option("enable-exception-handling"sv, PropExceptionHandling)
@@ -171,6 +195,7 @@ struct DriverToolOptions {
         .add_option("gas-limit"sv, GasLim)
         .add_option("memory-page-limit"sv, MemLim)
         .add_option("forbidden-plugin"sv, ForbiddenPlugins)
+        .add_option("profile-generate"sv, ProfileGenerate)
         .add_option("enable-snapshot"sv, ConfEnableSnapshotting)
         .add_option("snapshot-input"sv, SnapshotInputDir)
         .add_option("snapshot-output"sv, SnapshotOutputDir)
@@ -18,18 +18,7 @@ TypeT<T> Executor::runAtomicWaitOp(Runtime::StackManager &StackMgr,
   ValVariant RawValue = StackMgr.pop();
   ValVariant &RawAddress = StackMgr.getTop();
 
-  uint32_t Address = RawAddress.get<uint32_t>();
-  if (Address >
-      std::numeric_limits<uint32_t>::max() - Instr.getMemoryOffset()) {
-    spdlog::error(ErrCode::Value::MemoryOutOfBounds);
-    spdlog::error(ErrInfo::InfoBoundary(
-        Address + static_cast<uint64_t>(Instr.getMemoryOffset()), sizeof(T),
-        MemInst.getBoundIdx()));
-    spdlog::error(
-        ErrInfo::InfoInstruction(Instr.getOpCode(), Instr.getOffset()));
-    return Unexpect(ErrCode::Value::MemoryOutOfBounds);
-  }
-  Address += Instr.getMemoryOffset();
+  const uint64_t Address = getEffectiveAddress(RawAddress, MemInst, Instr);
 
   if (Address % sizeof(T) != 0) {
     spdlog::error(ErrCode::Value::UnalignedAtomicAccess);
@@ -57,19 +46,7 @@ TypeT<T> Executor::runAtomicLoadOp(Runtime::StackManager &StackMgr,
                                    Runtime::Instance::MemoryInstance &MemInst,
                                    const AST::Instruction &Instr) {
   ValVariant &RawAddress = StackMgr.getTop();
-  uint32_t Address = RawAddress.get<uint32_t>();
-
-  if (Address >
-      std::numeric_limits<uint32_t>::max() - Instr.getMemoryOffset()) {
-    spdlog::error(ErrCode::Value::MemoryOutOfBounds);
-    spdlog::error(ErrInfo::InfoBoundary(
-        Address + static_cast<uint64_t>(Instr.getMemoryOffset()), sizeof(I),
-        MemInst.getBoundIdx()));
-    spdlog::error(
-        ErrInfo::InfoInstruction(Instr.getOpCode(), Instr.getOffset()));
-    return Unexpect(ErrCode::Value::MemoryOutOfBounds);
-  }
-  Address += Instr.getMemoryOffset();
+  const uint64_t Address = getEffectiveAddress(RawAddress, MemInst, Instr);
 
   if (Address % sizeof(I) != 0) {
     spdlog::error(ErrCode::Value::UnalignedAtomicAccess);
@@ -98,19 +75,7 @@ TypeT<T> Executor::runAtomicStoreOp(Runtime::StackManager &StackMgr,
                                     const AST::Instruction &Instr) {
   ValVariant RawValue = StackMgr.pop();
   ValVariant RawAddress = StackMgr.pop();
-  uint32_t Address = RawAddress.get<uint32_t>();
-
-  if (Address >
-      std::numeric_limits<uint32_t>::max() - Instr.getMemoryOffset()) {
-    spdlog::error(ErrCode::Value::MemoryOutOfBounds);
-    spdlog::error(ErrInfo::InfoBoundary(
-        Address + static_cast<uint64_t>(Instr.getMemoryOffset()), sizeof(I),
-        MemInst.getBoundIdx()));
-    spdlog::error(
-        ErrInfo::InfoInstruction(Instr.getOpCode(), Instr.getOffset()));
-    return Unexpect(ErrCode::Value::MemoryOutOfBounds);
-  }
-  Address += Instr.getMemoryOffset();
+  const uint64_t Address = getEffectiveAddress(RawAddress, MemInst, Instr);
 
   if (Address % sizeof(I) != 0) {
     spdlog::error(ErrCode::Value::UnalignedAtomicAccess);
@@ -139,19 +104,7 @@ TypeT<T> Executor::runAtomicAddOp(Runtime::StackManager &StackMgr,
                                   const AST::Instruction &Instr) {
   ValVariant RawValue = StackMgr.pop();
   ValVariant &RawAddress = StackMgr.getTop();
-  uint32_t Address = RawAddress.get<uint32_t>();
-
-  if (Address >
-      std::numeric_limits<uint32_t>::max() - Instr.getMemoryOffset()) {
-    spdlog::error(ErrCode::Value::MemoryOutOfBounds);
-    spdlog::error(ErrInfo::InfoBoundary(
-        Address + static_cast<uint64_t>(Instr.getMemoryOffset()), sizeof(I),
-        MemInst.getBoundIdx()));
-    spdlog::error(
-        ErrInfo::InfoInstruction(Instr.getOpCode(), Instr.getOffset()));
-    return Unexpect(ErrCode::Value::MemoryOutOfBounds);
-  }
-  Address += Instr.getMemoryOffset();
+  const uint64_t Address = getEffectiveAddress(RawAddress, MemInst, Instr);
 
   if (Address % sizeof(I) != 0) {
     spdlog::error(ErrCode::Value::UnalignedAtomicAccess);
@@ -181,19 +134,7 @@ TypeT<T> Executor::runAtomicSubOp(Runtime::StackManager &StackMgr,
                                   const AST::Instruction &Instr) {
   ValVariant RawValue = StackMgr.pop();
   ValVariant &RawAddress = StackMgr.getTop();
-  uint32_t Address = RawAddress.get<uint32_t>();
-
-  if (Address >
-      std::numeric_limits<uint32_t>::max() - Instr.getMemoryOffset()) {
-    spdlog::error(ErrCode::Value::MemoryOutOfBounds);
-    spdlog::error(ErrInfo::InfoBoundary(
-        Address + static_cast<uint64_t>(Instr.getMemoryOffset()), sizeof(I),
-        MemInst.getBoundIdx()));
-    spdlog::error(
-        ErrInfo::InfoInstruction(Instr.getOpCode(), Instr.getOffset()));
-    return Unexpect(ErrCode::Value::MemoryOutOfBounds);
-  }
-  Address += Instr.getMemoryOffset();
+  const uint64_t Address = getEffectiveAddress(RawAddress, MemInst, Instr);
 
   if (Address % sizeof(I) != 0) {
     spdlog::error(ErrCode::Value::UnalignedAtomicAccess);
@@ -223,19 +164,7 @@ TypeT<T> Executor::runAtomicOrOp(Runtime::StackManager &StackMgr,
                                  const AST::Instruction &Instr) {
   ValVariant RawValue = StackMgr.pop();
   ValVariant &RawAddress = StackMgr.getTop();
-  uint32_t Address = RawAddress.get<uint32_t>();
-
-  if (Address >
-      std::numeric_limits<uint32_t>::max() - Instr.getMemoryOffset()) {
-    spdlog::error(ErrCode::Value::MemoryOutOfBounds);
-    spdlog::error(ErrInfo::InfoBoundary(
-        Address + static_cast<uint64_t>(Instr.getMemoryOffset()), sizeof(I),
-        MemInst.getBoundIdx()));
-    spdlog::error(
-        ErrInfo::InfoInstruction(Instr.getOpCode(), Instr.getOffset()));
-    return Unexpect(ErrCode::Value::MemoryOutOfBounds);
-  }
-  Address += Instr.getMemoryOffset();
+  const uint64_t Address = getEffectiveAddress(RawAddress, MemInst, Instr);
 
   if (Address % sizeof(I) != 0) {
     spdlog::error(ErrCode::Value::UnalignedAtomicAccess);
@@ -265,19 +194,7 @@ TypeT<T> Executor::runAtomicAndOp(Runtime::StackManager &StackMgr,
                                   const AST::Instruction &Instr) {
   ValVariant RawValue = StackMgr.pop();
   ValVariant &RawAddress = StackMgr.getTop();
-  uint32_t Address = RawAddress.get<uint32_t>();
-
-  if (Address >
-      std::numeric_limits<uint32_t>::max() - Instr.getMemoryOffset()) {
-    spdlog::error(ErrCode::Value::MemoryOutOfBounds);
-    spdlog::error(ErrInfo::InfoBoundary(
-        Address + static_cast<uint64_t>(Instr.getMemoryOffset()), sizeof(I),
-        MemInst.getBoundIdx()));
-    spdlog::error(
-        ErrInfo::InfoInstruction(Instr.getOpCode(), Instr.getOffset()));
-    return Unexpect(ErrCode::Value::MemoryOutOfBounds);
-  }
-  Address += Instr.getMemoryOffset();
+  const uint64_t Address = getEffectiveAddress(RawAddress, MemInst, Instr);
 
   if (Address % sizeof(I) != 0) {
     spdlog::error(ErrCode::Value::UnalignedAtomicAccess);
@@ -307,19 +224,7 @@ TypeT<T> Executor::runAtomicXorOp(Runtime::StackManager &StackMgr,
                                   const AST::Instruction &Instr) {
   ValVariant RawValue = StackMgr.pop();
   ValVariant &RawAddress = StackMgr.getTop();
-  uint32_t Address = RawAddress.get<uint32_t>();
-
-  if (Address >
-      std::numeric_limits<uint32_t>::max() - Instr.getMemoryOffset()) {
-    spdlog::error(ErrCode::Value::MemoryOutOfBounds);
-    spdlog::error(ErrInfo::InfoBoundary(
-        Address + static_cast<uint64_t>(Instr.getMemoryOffset()), sizeof(I),
-        MemInst.getBoundIdx()));
-    spdlog::error(
-        ErrInfo::InfoInstruction(Instr.getOpCode(), Instr.getOffset()));
-    return Unexpect(ErrCode::Value::MemoryOutOfBounds);
-  }
-  Address += Instr.getMemoryOffset();
+  const uint64_t Address = getEffectiveAddress(RawAddress, MemInst, Instr);
 
   if (Address % sizeof(I) != 0) {
     spdlog::error(ErrCode::Value::UnalignedAtomicAccess);
@@ -350,19 +255,7 @@ Executor::runAtomicExchangeOp(Runtime::StackManager &StackMgr,
                               const AST::Instruction &Instr) {
   ValVariant RawValue = StackMgr.pop();
   ValVariant &RawAddress = StackMgr.getTop();
-  uint32_t Address = RawAddress.get<uint32_t>();
-
-  if (Address >
-      std::numeric_limits<uint32_t>::max() - Instr.getMemoryOffset()) {
-    spdlog::error(ErrCode::Value::MemoryOutOfBounds);
-    spdlog::error(ErrInfo::InfoBoundary(
-        Address + static_cast<uint64_t>(Instr.getMemoryOffset()), sizeof(I),
-        MemInst.getBoundIdx()));
-    spdlog::error(
-        ErrInfo::InfoInstruction(Instr.getOpCode(), Instr.getOffset()));
-    return Unexpect(ErrCode::Value::MemoryOutOfBounds);
-  }
-  Address += Instr.getMemoryOffset();
+  const uint64_t Address = getEffectiveAddress(RawAddress, MemInst, Instr);
 
   if (Address % sizeof(I) != 0) {
     spdlog::error(ErrCode::Value::UnalignedAtomicAccess);
@@ -394,19 +287,7 @@ Executor::runAtomicCompareExchangeOp(Runtime::StackManager &StackMgr,
   ValVariant RawReplacement = StackMgr.pop();
   ValVariant RawExpected = StackMgr.pop();
   ValVariant &RawAddress = StackMgr.getTop();
-  uint32_t Address = RawAddress.get<uint32_t>();
-
-  if (Address >
-      std::numeric_limits<uint32_t>::max() - Instr.getMemoryOffset()) {
-    spdlog::error(ErrCode::Value::MemoryOutOfBounds);
-    spdlog::error(ErrInfo::InfoBoundary(
-        Address + static_cast<uint64_t>(Instr.getMemoryOffset()), sizeof(I),
-        MemInst.getBoundIdx()));
-    spdlog::error(
-        ErrInfo::InfoInstruction(Instr.getOpCode(), Instr.getOffset()));
-    return Unexpect(ErrCode::Value::MemoryOutOfBounds);
-  }
-  Address += Instr.getMemoryOffset();
+  const uint64_t Address = getEffectiveAddress(RawAddress, MemInst, Instr);
 
   if (Address % sizeof(I) != 0) {
     spdlog::error(ErrCode::Value::UnalignedAtomicAccess);
@@ -434,7 +315,7 @@ Executor::runAtomicCompareExchangeOp(Runtime::StackManager &StackMgr,
 template <typename T>
 Expect<uint32_t>
 Executor::atomicWait(Runtime::Instance::MemoryInstance &MemInst,
-                     uint32_t Address, T Expected, int64_t Timeout) noexcept {
+                     uint64_t Address, T Expected, int64_t Timeout) noexcept {
   // The error message should be handled by the caller, or the AOT mode will
   // produce the duplicated messages.
   if (!MemInst.isShared()) {
@@ -455,37 +336,34 @@ Executor::atomicWait(Runtime::Instance::MemoryInstance &MemInst,
   auto *AtomicObj = MemInst.getPointer<std::atomic<T> *>(Address);
   assuming(AtomicObj);
 
+  // Compare and enqueue under the bucket lock, so that the notifiers on the
+  // same address cannot be missed.
+  auto &Bucket = getWaiterBucket(MemInst, Address);
+  std::unique_lock<decltype(Bucket.Mutex)> Locker(Bucket.Mutex);
   if (AtomicObj->load() != Expected) {
     return UINT32_C(1); // NotEqual
   }
 
-  decltype(WaiterMap)::iterator WaiterIterator;
-  {
-    std::unique_lock<decltype(WaiterMapMutex)> Locker(WaiterMapMutex);
-    WaiterIterator = WaiterMap.emplace(Address, &MemInst);
-  }
-
+  Waiter W(&MemInst, Address);
+  Bucket.push(W);
   cxx20::scope_exit ScopeExitHolder([&]() noexcept {
-    std::unique_lock<decltype(WaiterMapMutex)> Locker(WaiterMapMutex);
-    WaiterMap.erase(WaiterIterator);
+    // The notified waiter is already dequeued by the notifier.
+    if (!W.Notified) {
+      Bucket.remove(W);
+    }
   });
 
   while (true) {
-    std::unique_lock<decltype(WaiterIterator->second.Mutex)> Locker(
-        WaiterIterator->second.Mutex);
-    std::cv_status WaitResult = std::cv_status::no_timeout;
-    if (!Until) {
-      WaiterIterator->second.Cond.wait(Locker);
-    } else {
-      WaitResult = WaiterIterator->second.Cond.wait_until(Locker, *Until);
-    }
-    if (unlikely(StopToken.load(std::memory_order_relaxed) != 0)) {
+    if (unlikely(checkInterrupted())) {
       return Unexpect(ErrCode::Value::Interrupted);
     }
-    if (likely(AtomicObj->load() != Expected)) {
+    if (W.Notified) {
       return UINT32_C(0); // ok
     }
-    if (WaitResult == std::cv_status::timeout) {
+    if (!Until) {
+      W.Cond.wait(Locker);
+    } else if (W.Cond.wait_until(Locker, *Until) == std::cv_status::timeout &&
+               !W.Notified) {
       return UINT32_C(2); // Timed-out
     }
   }
@@ -15,17 +15,14 @@ TypeT<T> Executor::runLoadOp(Runtime::StackManager &StackMgr,
                              const AST::Instruction &Instr) {
   // Calculate EA
   ValVariant &Val = StackMgr.getTop();
-  if (Val.get<uint32_t>() >
-      std::numeric_limits<uint32_t>::max() - Instr.getMemoryOffset()) {
-    spdlog::error(ErrCode::Value::MemoryOutOfBounds);
-    spdlog::error(ErrInfo::InfoBoundary(
-        Val.get<uint32_t>() + static_cast<uint64_t>(Instr.getMemoryOffset()),
-        BitWidth / 8, MemInst.getBoundIdx()));
-    spdlog::error(
-        ErrInfo::InfoInstruction(Instr.getOpCode(), Instr.getOffset()));
-    return Unexpect(ErrCode::Value::MemoryOutOfBounds);
+  if (GuardPageCheck && MemInst.isGuarded()) {
+    // The out-of-bound access faults in the guard region.
+    const uint64_t EA = static_cast<uint64_t>(Val.get<uint32_t>()) +
+                        Instr.getMemoryOffset();
+    MemInst.loadValueGuarded<T, BitWidth / 8>(Val.emplace<T>(), EA);
+    return {};
   }
-  uint32_t EA = Val.get<uint32_t>() + Instr.getMemoryOffset();
+  const uint64_t EA = getEffectiveAddress(Val, MemInst, Instr);
 
   // Value = Mem.Data[EA : N / 8]
   if (auto Res = MemInst.loadValue<T, BitWidth / 8>(Val.emplace<T>(), EA);
@@ -45,17 +42,15 @@ TypeN<T> Executor::runStoreOp(Runtime::StackManager &StackMgr,
   T C = StackMgr.pop().get<T>();
 
   // Calculate EA = i + offset
-  uint32_t I = StackMgr.pop().get<uint32_t>();
-  if (I > std::numeric_limits<uint32_t>::max() - Instr.getMemoryOffset()) {
-    spdlog::error(ErrCode::Value::MemoryOutOfBounds);
-    spdlog::error(ErrInfo::InfoBoundary(
-        I + static_cast<uint64_t>(Instr.getMemoryOffset()), BitWidth / 8,
-        MemInst.getBoundIdx()));
-    spdlog::error(
-        ErrInfo::InfoInstruction(Instr.getOpCode(), Instr.getOffset()));
-    return Unexpect(ErrCode::Value::MemoryOutOfBounds);
+  const ValVariant I = StackMgr.pop();
+  if (GuardPageCheck && MemInst.isGuarded()) {
+    // The out-of-bound access faults in the guard region.
+    const uint64_t EA =
+        static_cast<uint64_t>(I.get<uint32_t>()) + Instr.getMemoryOffset();
+    MemInst.storeValueGuarded<T, BitWidth / 8>(C, EA);
+    return {};
   }
-  uint32_t EA = I + Instr.getMemoryOffset();
+  const uint64_t EA = getEffectiveAddress(I, MemInst, Instr);
 
   // Store value to bytes.
   if (auto Res = MemInst.storeValue<T, BitWidth / 8>(C, EA); !Res) {
@@ -74,17 +69,7 @@ Executor::runLoadExpandOp(Runtime::StackManager &StackMgr,
   static_assert(sizeof(TOut) == sizeof(TIn) * 2);
   // Calculate EA
   ValVariant &Val = StackMgr.getTop();
-  if (Val.get<uint32_t>() >
-      std::numeric_limits<uint32_t>::max() - Instr.getMemoryOffset()) {
-    spdlog::error(ErrCode::Value::MemoryOutOfBounds);
-    spdlog::error(ErrInfo::InfoBoundary(
-        Val.get<uint32_t>() + static_cast<uint64_t>(Instr.getMemoryOffset()), 8,
-        MemInst.getBoundIdx()));
-    spdlog::error(
-        ErrInfo::InfoInstruction(Instr.getOpCode(), Instr.getOffset()));
-    return Unexpect(ErrCode::Value::MemoryOutOfBounds);
-  }
-  uint32_t EA = Val.get<uint32_t>() + Instr.getMemoryOffset();
+  const uint64_t EA = getEffectiveAddress(Val, MemInst, Instr);
 
   // Value = Mem.Data[EA : N / 8]
   uint64_t Buffer;
@@ -118,17 +103,7 @@ Executor::runLoadSplatOp(Runtime::StackManager &StackMgr,
                          const AST::Instruction &Instr) {
   // Calculate EA
   ValVariant &Val = StackMgr.getTop();
-  if (Val.get<uint32_t>() >
-      std::numeric_limits<uint32_t>::max() - Instr.getMemoryOffset()) {
-    spdlog::error(ErrCode::Value::MemoryOutOfBounds);
-    spdlog::error(ErrInfo::InfoBoundary(
-        Val.get<uint32_t>() + static_cast<uint64_t>(Instr.getMemoryOffset()),
-        sizeof(T), MemInst.getBoundIdx()));
-    spdlog::error(
-        ErrInfo::InfoInstruction(Instr.getOpCode(), Instr.getOffset()));
-    return Unexpect(ErrCode::Value::MemoryOutOfBounds);
-  }
-  uint32_t EA = Val.get<uint32_t>() + Instr.getMemoryOffset();
+  const uint64_t EA = getEffectiveAddress(Val, MemInst, Instr);
 
   // Value = Mem.Data[EA : N / 8]
   using VT = SIMDArray<T, 16>;
@@ -163,17 +138,7 @@ Expect<void> Executor::runLoadLaneOp(Runtime::StackManager &StackMgr,
 
   // Calculate EA
   ValVariant &Val = StackMgr.getTop();
-  const uint32_t Offset = Val.get<uint32_t>();
-  if (Offset > std::numeric_limits<uint32_t>::max() - Instr.getMemoryOffset()) {
-    spdlog::error(ErrCode::Value::MemoryOutOfBounds);
-    spdlog::error(ErrInfo::InfoBoundary(
-        Offset + static_cast<uint64_t>(Instr.getMemoryOffset()), sizeof(T),
-        MemInst.getBoundIdx()));
-    spdlog::error(
-        ErrInfo::InfoInstruction(Instr.getOpCode(), Instr.getOffset()));
-    return Unexpect(ErrCode::Value::MemoryOutOfBounds);
-  }
-  const uint32_t EA = Offset + Instr.getMemoryOffset();
+  const uint64_t EA = getEffectiveAddress(Val, MemInst, Instr);
 
   // Value = Mem.Data[EA : N / 8]
   uint64_t Buffer;
@@ -199,17 +164,7 @@ Executor::runStoreLaneOp(Runtime::StackManager &StackMgr,
   const TBuf C = StackMgr.pop().get<VT>()[Instr.getMemoryLane()];
 
   // Calculate EA = i + offset
-  uint32_t I = StackMgr.pop().get<uint32_t>();
-  if (I > std::numeric_limits<uint32_t>::max() - Instr.getMemoryOffset()) {
-    spdlog::error(ErrCode::Value::MemoryOutOfBounds);
-    spdlog::error(ErrInfo::InfoBoundary(
-        I + static_cast<uint64_t>(Instr.getMemoryOffset()), sizeof(T),
-        MemInst.getBoundIdx()));
-    spdlog::error(
-        ErrInfo::InfoInstruction(Instr.getOpCode(), Instr.getOffset()));
-    return Unexpect(ErrCode::Value::MemoryOutOfBounds);
-  }
-  uint32_t EA = I + Instr.getMemoryOffset();
+  const uint64_t EA = getEffectiveAddress(StackMgr.pop(), MemInst, Instr);
 
   // Store value to bytes.
   if (auto Res = MemInst.storeValue<decltype(C), sizeof(T)>(C, EA); !Res) {
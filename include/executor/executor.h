@@ -18,13 +18,18 @@
 #include "common/async.h"
 #include "common/configure.h"
 #include "common/defines.h"
+#include "common/epoch.h"
 #include "common/errcode.h"
+#include "common/profile.h"
 #include "common/statistics.h"
+#include "common/threadpool.h"
 #include "runtime/callingframe.h"
 #include "runtime/instance/module.h"
 #include "runtime/stackmgr.h"
 #include "runtime/storemgr.h"
 
+#include <algorithm>
+#include <array>
 #include <atomic>
 #include <condition_variable>
 #include <csignal>
@@ -36,6 +41,7 @@
 #include <shared_mutex>
 #include <string_view>
 #include <type_traits>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -126,7 +132,7 @@ private:
 class Executor {
 public:
   Executor(const Configure &Conf, Statistics::Statistics *S = nullptr) noexcept
-      : Conf(Conf) {
+      : Conf(Conf), AsyncPool(Conf.getRuntimeConfigure().getMaxThreads()) {
     if (Conf.getStatisticsConfigure().isInstructionCounting() ||
         Conf.getStatisticsConfigure().isCostMeasuring() ||
         Conf.getStatisticsConfigure().isTimeMeasuring() ||
@@ -138,9 +144,17 @@ public:
     if (Stat) {
       Stat->setCostLimit(Conf.getStatisticsConfigure().getCostLimit());
     }
+    GuardPageCheck = Conf.getRuntimeConfigure().isGuardPageCheck();
+    if (Conf.getStatisticsConfigure().isProfiling()) {
+      Profiling = std::make_unique<ProfileCounters>();
+    }
   }
   ~Executor() noexcept {
-    ExecutionContext.StopToken = nullptr;
+    if (EpochAcquired) {
+      Epoch::release();
+    }
+    ExecutionContext.Epoch = nullptr;
+    ExecutionContext.Deadline = nullptr;
     ExecutionContext.InstrCount = nullptr;
     ExecutionContext.CostTable = nullptr;
     ExecutionContext.Gas = nullptr;
@@ -149,6 +163,9 @@ public:
   /// Getter of Configure
   const Configure &getConfigure() const { return Conf; }
 
+  /// Getter of the worker pool for the asynchronous executions.
+  ThreadPool &getAsyncPool() noexcept { return AsyncPool; }
+
   /// Instantiate a WASM Module into an anonymous module instance.
   Expect<std::unique_ptr<Runtime::Instance::ModuleInstance>>
   instantiateModule(Runtime::StoreManager &StoreMgr, const AST::Module &Mod);
@@ -183,6 +200,24 @@ public:
   Expect<void> registerPostHostFunction(void *HostData,
                                         std::function<void(void *)> HostFunc);
 
+  /// Register a function which will be invoked when a native function becomes
+  /// hot in the tiered execution. The function should compile it in the
+  /// background and set the compiled code into the function instance. The
+  /// tiered execution is disabled if nullptr.
+  void registerTierUpFunction(
+      std::function<void(const Runtime::Instance::FunctionInstance &)>
+          Func) noexcept {
+    TierUpFunc = std::move(Func);
+    TierUpThreshold =
+        TierUpFunc
+            ? std::max(Conf.getRuntimeConfigure().getTierUpThreshold(), 1U)
+            : 0U;
+  }
+
+  /// Getter of the execution counts of the functions in the module instance
+  /// collected in the profiling mode.
+  Profile getProfile(const Runtime::Instance::ModuleInstance &ModInst) const;
+
   /// Invoke a WASM function by function instance.
   Expect<std::vector<std::pair<ValVariant, ValType>>>
   invoke(const Runtime::Instance::FunctionInstance *FuncInst,
@@ -195,10 +230,26 @@ public:
 
   /// Stop execution
   void stop() noexcept {
-    StopToken.store(1, std::memory_order_relaxed);
+    Deadline.store(0, std::memory_order_relaxed);
     atomicNotifyAll();
   }
 
+  /// Interrupt the executions when the time point is reached. The earliest
+  /// one takes effect if set several times, and is cleared after the
+  /// interruption.
+  template <typename CT, typename DT>
+  void setTimeLimit(const std::chrono::time_point<CT, DT> &Time) {
+    if (!EpochAcquired) {
+      Epoch::acquire();
+      EpochAcquired = true;
+    }
+    const uint64_t Target = Epoch::toEpoch(Time);
+    uint64_t Curr = Deadline.load(std::memory_order_relaxed);
+    while (Target < Curr && !Deadline.compare_exchange_weak(
+                                Curr, Target, std::memory_order_relaxed)) {
+    }
+  }
+
 private:
   /// Run Wasm bytecode expression for initialization.
   Expect<void> runExpression(Runtime::StackManager &StackMgr,
@@ -214,6 +265,12 @@ private:
                        const AST::InstrView::iterator Start,
                        const AST::InstrView::iterator End);
 
+  /// Execute instructions with the fault handler for the guard page bounds
+  /// checking.
+  Expect<void> executeGuarded(Runtime::StackManager &StackMgr,
+                              const AST::InstrView::iterator Start,
+                              const AST::InstrView::iterator End);
+
   /// \name Functions for instantiation.
   /// @{
   /// Instantiation of Module Instance.
@@ -221,6 +278,10 @@ private:
   instantiate(Runtime::StoreManager &StoreMgr, const AST::Module &Mod,
               std::optional<std::string_view> Name = std::nullopt);
 
+  /// Instantiation of Defined Types.
+  Expect<void> instantiate(Runtime::Instance::ModuleInstance &ModInst,
+                           const AST::TypeSection &TypeSec);
+
   /// Instantiation of Imports.
   Expect<void> instantiate(Runtime::StoreManager &StoreMgr,
                            Runtime::Instance::ModuleInstance &ModInst,
@@ -325,6 +386,20 @@ private:
 
   /// \name Helper Functions for block controls.
   /// @{
+  /// Helper function for loading the lazy function body before calling.
+  Expect<void>
+  prepareFunction(const Runtime::Instance::FunctionInstance &Func) noexcept;
+
+  /// Helper function for checking the interruption. The deadline is cleared
+  /// when interrupted.
+  bool checkInterrupted() noexcept {
+    if (likely(Epoch::load() < Deadline.load(std::memory_order_relaxed))) {
+      return false;
+    }
+    Deadline.store(UINT64_MAX, std::memory_order_relaxed);
+    return true;
+  }
+
   /// Helper function for calling functions. Return the continuation iterator.
   Expect<AST::InstrView::iterator>
   enterFunction(Runtime::StackManager &StackMgr,
@@ -376,6 +451,9 @@ private:
   Runtime::Instance::DataInstance *
   getDataInstByIdx(Runtime::StackManager &StackMgr, const uint32_t Idx) const;
 
+  /// Helper function for assigning canonical IDs to the defined types.
+  void canonicalizeTypes(const Runtime::Instance::ModuleInstance &ModInst);
+
   /// Helper function for converting into bottom abstract heap type.
   TypeCode toBottomType(Runtime::StackManager &StackMgr,
                         const ValType &Type) const;
@@ -537,6 +615,24 @@ private:
                               Runtime::Instance::TableInstance &TabInst,
                               const AST::Instruction &Instr);
   /// ======= Memory instructions =======
+  /// Get the address operand, which is i64 for the 64-bit memories.
+  static uint64_t
+  getMemoryAddress(const ValVariant &Val,
+                   const Runtime::Instance::MemoryInstance &MemInst) noexcept {
+    return MemInst.is64() ? Val.get<uint64_t>() : Val.get<uint32_t>();
+  }
+  /// Calculate the effective address of the memory instruction. The result is
+  /// saturated on overflow and fails in the boundary checking.
+  static uint64_t
+  getEffectiveAddress(const ValVariant &Val,
+                      const Runtime::Instance::MemoryInstance &MemInst,
+                      const AST::Instruction &Instr) noexcept {
+    const uint64_t Addr = getMemoryAddress(Val, MemInst);
+    const uint64_t Offset = Instr.getMemoryOffset();
+    return Addr > std::numeric_limits<uint64_t>::max() - Offset
+               ? std::numeric_limits<uint64_t>::max()
+               : Addr + Offset;
+  }
   template <typename T, uint32_t BitWidth = sizeof(T) * 8>
   TypeT<T> runLoadOp(Runtime::StackManager &StackMgr,
                      Runtime::Instance::MemoryInstance &MemInst,
@@ -875,27 +971,65 @@ public:
 private:
   template <typename T>
   Expect<uint32_t> atomicWait(Runtime::Instance::MemoryInstance &MemInst,
-                              uint32_t Address, T Expected,
+                              uint64_t Address, T Expected,
                               int64_t Timeout) noexcept;
   Expect<uint32_t> atomicNotify(Runtime::Instance::MemoryInstance &MemInst,
-                                uint32_t Address, uint32_t Count) noexcept;
+                                uint64_t Address, uint32_t Count) noexcept;
   void atomicNotifyAll() noexcept;
 
+  /// Waiter of the atomic wait, allocated on the stack of the waiting thread
+  /// and linked into the bucket of its (memory, address) key.
   struct Waiter {
-    std::mutex Mutex;
-    std::condition_variable Cond;
+    Waiter(Runtime::Instance::MemoryInstance *Inst, uint64_t Addr) noexcept
+        : MemInst(Inst), Address(Addr) {}
     Runtime::Instance::MemoryInstance *MemInst;
-    Waiter(Runtime::Instance::MemoryInstance *Inst) noexcept : MemInst(Inst) {}
+    uint64_t Address;
+    std::condition_variable Cond;
+    bool Notified = false;
+    Waiter *Prev = nullptr;
+    Waiter *Next = nullptr;
   };
-  std::mutex WaiterMapMutex;
-  std::unordered_multimap<uint32_t, Waiter> WaiterMap;
+
+  /// Bucket of the waiter table. The waiters are queued in FIFO order and
+  /// guarded by the bucket mutex.
+  struct alignas(64) WaiterBucket {
+    std::mutex Mutex;
+    Waiter *Head = nullptr;
+    Waiter *Tail = nullptr;
+
+    void push(Waiter &W) noexcept {
+      W.Prev = Tail;
+      W.Next = nullptr;
+      (Tail ? Tail->Next : Head) = &W;
+      Tail = &W;
+    }
+    void remove(Waiter &W) noexcept {
+      (W.Prev ? W.Prev->Next : Head) = W.Next;
+      (W.Next ? W.Next->Prev : Tail) = W.Prev;
+      W.Prev = W.Next = nullptr;
+    }
+  };
+
+  /// Get the bucket of the waiters on the address of the memory instance.
+  WaiterBucket &
+  getWaiterBucket(const Runtime::Instance::MemoryInstance &MemInst,
+                  uint64_t Address) noexcept {
+    uint64_t Key = reinterpret_cast<uintptr_t>(&MemInst) ^
+                   (static_cast<uint64_t>(Address) << 16);
+    Key *= UINT64_C(0x9E3779B97F4A7C15);
+    return WaiterBuckets[Key >> (64 - kWaiterBucketBits)];
+  }
+
+  static inline constexpr const uint32_t kWaiterBucketBits = 6;
+  std::array<WaiterBucket, 1U << kWaiterBucketBits> WaiterBuckets;
 
 private:
   /// Prepare execution context
   void prepare(Runtime::StackManager &StackMgr, uint8_t *const *Memories,
                ValVariant *const *Globals) noexcept {
     This = this;
-    ExecutionContext.StopToken = &StopToken;
+    ExecutionContext.Epoch = &Epoch::getCounter();
+    ExecutionContext.Deadline = &Deadline;
     ExecutionContext.Memories = Memories;
     ExecutionContext.Globals = Globals;
     if (Stat) {
@@ -915,7 +1049,8 @@ private:
     uint64_t *CostTable;
     std::atomic_uint64_t *Gas;
     uint64_t GasLimit;
-    std::atomic_uint32_t *StopToken;
+    std::atomic_uint64_t *Epoch;
+    std::atomic_uint64_t *Deadline;
   };
 
   /// Pointer to current object.
@@ -931,10 +1066,31 @@ private:
   const Configure Conf;
   /// Executor statistics
   Statistics::Statistics *Stat;
-  /// Stop Execution
-  std::atomic_uint32_t StopToken = 0;
+  /// Guard page bounds checking for the loads and stores
+  bool GuardPageCheck = false;
+  /// Hot count threshold of the tiered execution, 0 for disabled.
+  uint32_t TierUpThreshold = 0;
+  /// Callback for the hot functions in the tiered execution.
+  std::function<void(const Runtime::Instance::FunctionInstance &)> TierUpFunc;
+  /// Execution counts of the interpreter in the profiling mode.
+  struct ProfileCounters {
+    std::mutex Mutex;
+    std::unordered_map<const Runtime::Instance::FunctionInstance *, uint64_t>
+        Functions;
+    std::unordered_map<const AST::Instruction *, Profile::BranchCount>
+        Branches;
+  };
+  std::unique_ptr<ProfileCounters> Profiling;
+  /// Epoch to interrupt the executions, 0 for stopping immediately. Compared
+  /// with the process-wide epoch instead of exchanged, for the checks are in
+  /// the hot paths.
+  std::atomic_uint64_t Deadline = UINT64_MAX;
+  bool EpochAcquired = false;
   /// Executor Host Function Handler
   HostFuncHandler HostFuncHelper = {};
+  /// Worker pool for the asynchronous executions. Declared last to join the
+  /// workers before destructing the other members.
+  ThreadPool AsyncPool;
 };
 
 } // namespace Executor
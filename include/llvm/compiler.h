@@ -13,27 +13,71 @@
 //===----------------------------------------------------------------------===//
 #pragma once
 
+#include "aot/target.h"
 #include "ast/module.h"
 #include "common/configure.h"
 #include "common/errcode.h"
 #include "common/filesystem.h"
+#include "common/profile.h"
 #include "common/span.h"
 #include "llvm/data.h"
 
 #include <mutex>
+#include <optional>
+#include <string>
 
 namespace WasmEdge::LLVM {
 
 /// Compiling Module into LLVM Module.
 class Compiler {
 public:
-  Compiler(const Configure &Conf) noexcept : Context(nullptr), Conf(Conf) {}
+  Compiler(const Configure &Conf) noexcept
+      : Context(nullptr), Conf(Conf),
+        Target(Conf.getCompilerConfigure().isGenericBinary()
+                   ? AOT::TargetLevel::Generic
+                   : AOT::TargetLevel::Host) {}
 
+  /// Compile the module. For the fat binary, the returned data holds the
+  /// variants of the other target levels.
   Expect<Data> compile(const AST::Module &Module) noexcept;
 
+  /// Compile only the defined function Index of the code section for the
+  /// tiered execution. The calls to the other functions go through the
+  /// executor.
+  Expect<Data> compileFunction(const AST::Module &Module,
+                               uint32_t Index) noexcept;
+
+  /// Compile only the type wrappers and the globals of the module for the lazy
+  /// JIT. The defined functions are compiled by compileLazyFunction() on their
+  /// first calls.
+  Expect<Data> compileLazy(const AST::Module &Module) noexcept;
+
+  /// Compile the defined function Index of the code section for the lazy JIT.
+  /// The calls to the other functions go through their symbols.
+  Expect<Data> compileLazyFunction(const AST::Module &Module,
+                                   uint32_t Index) noexcept;
+
+  /// Get the key of the compiler options, the runtime version, and the host
+  /// target, which decide the compiled code of a module.
+  std::string getCacheKey() const;
+
+  /// Setter of the execution profile for the profile-guided optimization.
+  void setProfile(Profile P) noexcept { Prof = std::move(P); }
+
   struct CompileContext;
 
 private:
+  /// Compile the whole module in the function partitions for the target
+  /// level.
+  Expect<Data> compileTarget(const AST::Module &Module,
+                             AOT::TargetLevel Level) noexcept;
+
+  /// Compile the defined functions [Begin, End) of the code section into a
+  /// module. The partition 0 also holds the type wrappers and the globals.
+  Expect<Data> compilePartition(const AST::Module &Module, uint32_t Index,
+                                size_t Begin, size_t End,
+                                bool IsStandalone = false) noexcept;
+
   void compile(const AST::ImportSection &ImportSection) noexcept;
   void compile(const AST::ExportSection &ExportSection) noexcept;
   void compile(const AST::TypeSection &TypeSection) noexcept;
@@ -48,6 +92,8 @@ private:
   std::mutex Mutex;
   CompileContext *Context;
   const Configure Conf;
+  AOT::TargetLevel Target;
+  std::optional<Profile> Prof;
 };
 
 } // namespace WasmEdge::LLVM
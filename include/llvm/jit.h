@@ -17,6 +17,8 @@
 #include "common/configure.h"
 #include "common/errcode.h"
 #include "llvm/data.h"
+
+#include <memory>
 #include <vector>
 
 namespace WasmEdge::LLVM {
@@ -24,7 +26,11 @@ class OrcLLJIT;
 
 class JITLibrary : public Executable {
 public:
+  /// Stubs and compiling states of the lazily compiled functions.
+  struct LazyContext;
+
   JITLibrary(OrcLLJIT JIT) noexcept;
+  JITLibrary(OrcLLJIT JIT, std::unique_ptr<LazyContext> Lazy) noexcept;
   ~JITLibrary() noexcept override;
 
   Symbol<const IntrinsicsTable *> getIntrinsics() noexcept override;
@@ -36,6 +42,8 @@ public:
 
 private:
   OrcLLJIT *J;
+  /// Released after the JIT, which holds the stubs.
+  std::unique_ptr<LazyContext> Lazy;
 };
 
 class JIT {
@@ -43,6 +51,11 @@ public:
   JIT(const Configure &Conf) noexcept : Conf(Conf) {}
   Expect<std::shared_ptr<Executable>> load(Data D) noexcept;
 
+  /// Compile and load the module lazily. The defined functions are called
+  /// through the stubs, and each of them is compiled on its first call.
+  Expect<std::shared_ptr<Executable>>
+  loadLazy(const AST::Module &Module) noexcept;
+
 private:
   const Configure Conf;
 };
@@ -340,7 +340,7 @@ private:
   Expect<ValMut> loadMutability(ASTNodeAttr From);
   Expect<void> loadFieldType(AST::FieldType &FType);
   Expect<void> loadCompositeType(AST::CompositeType &CType);
-  Expect<void> loadLimit(AST::Limit &Lim);
+  Expect<void> loadLimit(AST::Limit &Lim, bool Allow64 = false);
   Expect<void> loadType(AST::SubType &SType);
   Expect<void> loadType(AST::FunctionType &FuncType);
   Expect<void> loadType(AST::MemoryType &MemType);
@@ -423,6 +423,7 @@ private:
   Expect<OpCode> loadOpCode();
   Expect<AST::InstrVec> loadInstrSeq(std::optional<uint64_t> SizeBound);
   Expect<void> loadInstruction(AST::Instruction &Instr);
+  Expect<AST::InstrVec> loadLazyInstrSeq(Span<const Byte> Code, bool HasData);
   /// @}
 
   /// \name Loader members
@@ -433,6 +434,8 @@ private:
   const Executable::IntrinsicsTable *IntrinsicsTable;
   std::recursive_mutex Mutex;
   bool HasDataSection;
+  /// Loader for decoding the function bodies in lazy validation mode.
+  std::shared_ptr<Loader> LazyLoader;
 
   /// Input data type enumeration.
   enum class InputType : uint8_t { WASM, UniversalWASM, SharedLibrary };
@@ -39,6 +39,17 @@ public:
                            Span<const ValVariant> Args,
                            Span<ValVariant> Rets) = 0;
 
+  /// Run host function body with the arguments and returns matching the
+  /// function type. Dispatch to the typed thunk if provided, otherwise fall
+  /// back to the virtual `run`.
+  Expect<void> runDirect(const CallingFrame &CallFrame,
+                         Span<const ValVariant> Args, Span<ValVariant> Rets) {
+    if (likely(Thunk != nullptr)) {
+      return Thunk(*this, CallFrame, Args, Rets);
+    }
+    return run(CallFrame, Args, Rets);
+  }
+
   /// Getter of function type.
   const AST::FunctionType &getFuncType() const noexcept {
     return DefType.getCompositeType().getFuncType();
@@ -51,14 +62,20 @@ public:
   const AST::SubType &getDefinedType() const noexcept { return DefType; }
 
 protected:
+  /// Typed entry of the host function without the signature checking.
+  using ThunkT = Expect<void> (*)(HostFunctionBase &, const CallingFrame &,
+                                  Span<const ValVariant>, Span<ValVariant>);
+
   AST::SubType DefType;
   const uint64_t Cost;
+  ThunkT Thunk = nullptr;
 };
 
 template <typename T> class HostFunction : public HostFunctionBase {
 public:
   HostFunction(const uint64_t FuncCost = 0) : HostFunctionBase(FuncCost) {
     initializeFuncType();
+    Thunk = &thunk;
   }
 
   Expect<void> run(const CallingFrame &CallFrame, Span<const ValVariant> Args,
@@ -112,6 +129,18 @@ protected:
   }
 
 private:
+  /// Generated thunk of the `T::body`. The arguments and returns count are
+  /// guaranteed by the function type, so they are unpacked with the static
+  /// extents directly.
+  static Expect<void> thunk(HostFunctionBase &Self,
+                            const CallingFrame &CallFrame,
+                            Span<const ValVariant> Args,
+                            Span<ValVariant> Rets) {
+    using F = FuncTraits<decltype(&T::body)>;
+    return static_cast<HostFunction &>(Self).invoke(
+        CallFrame, Args.first<F::ArgsN>(), Rets.first<F::RetsN>());
+  }
+
   template <typename U> struct Wrap {
     using Type = std::tuple<U>;
   };
@@ -14,11 +14,14 @@
 #pragma once
 
 #include "ast/instruction.h"
+#include "ast/segment.h"
 #include "common/symbol.h"
 #include "runtime/hostfunc.h"
 #include "runtime/instance/composite.h"
 
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <numeric>
 #include <string>
 #include <vector>
@@ -37,7 +40,12 @@ public:
   /// Move constructor.
   FunctionInstance(FunctionInstance &&Inst) noexcept
       : CompositeBase(Inst.ModInst, Inst.TypeIdx), FuncType(Inst.FuncType),
-        Data(std::move(Inst.Data)) {
+        Data(std::move(Inst.Data)),
+        HotCount(Inst.HotCount.load(std::memory_order_relaxed)),
+        TierUpQueued(Inst.TierUpQueued.load(std::memory_order_relaxed)),
+        TierUpWrapper(std::move(Inst.TierUpWrapper)),
+        TierUpSymbol(std::move(Inst.TierUpSymbol)),
+        TierUpCode(Inst.TierUpCode.load(std::memory_order_relaxed)) {
     assuming(ModInst);
   }
   /// Constructor for native function.
@@ -49,6 +57,20 @@ public:
         Data(std::in_place_type_t<WasmFunction>(), Locs, Expr) {
     assuming(ModInst);
   }
+  /// Constructor for native function in lazy validation mode.
+  FunctionInstance(const ModuleInstance *Mod, const uint32_t TIdx,
+                   const AST::FunctionType &Type,
+                   Span<const std::pair<uint32_t, ValType>> Locs,
+                   AST::InstrView Expr, AST::CodeSegment::LazyDecoder Decoder,
+                   AST::CodeSegment::LazyChecker Checker) noexcept
+      : CompositeBase(Mod, TIdx), FuncType(Type),
+        Data(std::in_place_type_t<WasmFunction>(), Locs, Expr) {
+    assuming(ModInst);
+    if (Decoder) {
+      std::get<WasmFunction>(Data).Lazy = std::make_unique<LazyBody>(
+          std::move(Decoder), std::move(Checker));
+    }
+  }
   /// Constructor for compiled function.
   FunctionInstance(const ModuleInstance *Mod, const uint32_t TIdx,
                    const AST::FunctionType &Type,
@@ -114,6 +136,39 @@ public:
     }
   }
 
+  /// Getter of checking is the function body loaded in lazy validation mode.
+  bool isLazyFunction() const noexcept {
+    const auto *Func = std::get_if<WasmFunction>(&Data);
+    return Func && Func->Lazy;
+  }
+
+  /// Decode and validate the function body in lazy validation mode. Only the
+  /// first call does the work, and the later calls return the same result.
+  Expect<void> loadLazyBody(Span<const AST::SubType *const> Types) const {
+    const auto &Func = std::get<WasmFunction>(Data);
+    LazyBody &Lazy = *Func.Lazy;
+    std::call_once(Lazy.Flag, [&]() {
+      auto Instrs = Lazy.Decoder();
+      if (!Instrs) {
+        Lazy.Result = Unexpect(Instrs);
+        return;
+      }
+      if (!Lazy.Checker) {
+        // Not validated.
+        Lazy.Result = Unexpect(ErrCode::Value::NotValidated);
+        return;
+      }
+      if (auto Res = Lazy.Checker(*Instrs, Types); !Res) {
+        Lazy.Result = Unexpect(Res);
+        return;
+      }
+      Func.Instrs.reserve(Instrs->size() + 1);
+      Func.Instrs.assign(std::make_move_iterator(Instrs->begin()),
+                         std::make_move_iterator(Instrs->end()));
+    });
+    return Lazy.Result;
+  }
+
   /// Getter of symbol
   auto &getSymbol() const noexcept {
     return *std::get_if<Symbol<CompiledFunction>>(&Data);
@@ -124,11 +179,60 @@ public:
     return *std::get_if<std::unique_ptr<HostFunctionBase>>(&Data)->get();
   }
 
+  /// Count a call or a back edge of the native function in the tiered
+  /// execution. Returns true only once when the count reaches the threshold,
+  /// and the caller should queue this function for compiling.
+  bool addHotness(uint32_t Threshold) const noexcept {
+    // The racy increment may lose counts in the concurrent executions, which
+    // only delays the compiling.
+    const uint32_t Count = HotCount.load(std::memory_order_relaxed);
+    if (likely(Count < Threshold)) {
+      HotCount.store(Count + 1, std::memory_order_relaxed);
+      return false;
+    }
+    return !TierUpQueued.load(std::memory_order_relaxed) &&
+           !TierUpQueued.exchange(true, std::memory_order_relaxed);
+  }
+
+  /// Getter of the compiled code of the native function in the tiered
+  /// execution, or nullptr if not compiled yet.
+  CompiledFunction *getTierUpCode() const noexcept {
+    return TierUpCode.load(std::memory_order_acquire);
+  }
+
+  /// Getter of the wrapper of the compiled code. Only valid after the compiled
+  /// code is got.
+  const Symbol<Executable::Wrapper> &getTierUpWrapper() const noexcept {
+    return TierUpWrapper;
+  }
+
+  /// Setter of the compiled code and its wrapper of the native function. Can
+  /// be set only once and the later calls of this function switch to the
+  /// compiled code.
+  void setTierUpSymbol(Symbol<Executable::Wrapper> W,
+                       Symbol<CompiledFunction> S) const noexcept {
+    assuming(isWasmFunction() && !getTierUpCode());
+    TierUpWrapper = std::move(W);
+    TierUpSymbol = std::move(S);
+    TierUpCode.store(TierUpSymbol.get(), std::memory_order_release);
+  }
+
 private:
+  struct LazyBody {
+    LazyBody(AST::CodeSegment::LazyDecoder &&D,
+             AST::CodeSegment::LazyChecker &&C) noexcept
+        : Decoder(std::move(D)), Checker(std::move(C)) {}
+    AST::CodeSegment::LazyDecoder Decoder;
+    AST::CodeSegment::LazyChecker Checker;
+    std::once_flag Flag;
+    Expect<void> Result;
+  };
   struct WasmFunction {
     const std::vector<std::pair<uint32_t, ValType>> Locals;
     const uint32_t LocalNum;
-    AST::InstrVec Instrs;
+    mutable AST::InstrVec Instrs;
+    /// Function body to be decoded and validated in lazy validation mode.
+    std::unique_ptr<LazyBody> Lazy;
     WasmFunction(Span<const std::pair<uint32_t, ValType>> Locs,
                  AST::InstrView Expr) noexcept
         : Locals(Locs.begin(), Locs.end()),
@@ -151,6 +255,15 @@ private:
                std::unique_ptr<HostFunctionBase>>
       Data;
   /// @}
+
+  /// \name Data of the tiered execution.
+  /// @{
+  mutable std::atomic<uint32_t> HotCount = 0;
+  mutable std::atomic<bool> TierUpQueued = false;
+  mutable Symbol<Executable::Wrapper> TierUpWrapper;
+  mutable Symbol<CompiledFunction> TierUpSymbol;
+  mutable std::atomic<CompiledFunction *> TierUpCode = nullptr;
+  /// @}
 };
 
 } // namespace Instance
@@ -18,6 +18,7 @@
 #include "common/errinfo.h"
 #include "common/spdlog.h"
 #include "system/allocator.h"
+#include "system/bulkmem.h"
 
 #include <algorithm>
 #include <cstdint>
@@ -38,33 +39,52 @@ class MemoryInstance {
 public:
   static inline constexpr const uint64_t kPageSize = UINT64_C(65536);
   static inline constexpr const uint64_t k4G = UINT64_C(0x100000000);
+  /// Maximum reserved pages of the 64-bit memory, 1 TiB.
+  static inline constexpr const uint32_t kMax64ReservePages = UINT32_C(1)
+                                                              << 24;
   MemoryInstance() = delete;
   MemoryInstance(MemoryInstance &&Inst) noexcept
       : MemType(Inst.MemType), DataPtr(Inst.DataPtr),
-        PageLimit(Inst.PageLimit) {
+        PageLimit(Inst.PageLimit), AllocPolicy(Inst.AllocPolicy),
+        CommittedPages(Inst.CommittedPages) {
     Inst.DataPtr = nullptr;
   }
   MemoryInstance(const AST::MemoryType &MType,
-                 uint32_t PageLim = UINT32_C(65536)) noexcept
-      : MemType(MType), PageLimit(PageLim) {
+                 uint32_t PageLim = UINT32_C(65536),
+                 Allocator::Policy Policy = {}) noexcept
+      : MemType(MType), PageLimit(PageLim), AllocPolicy(Policy) {
     if (MemType.getLimit().getMin() > PageLimit) {
       spdlog::error("Memory Instance: Limited {} page in configuration.",
                     PageLimit);
       MemType.getLimit().setMin(PageLimit);
     }
-    DataPtr = Allocator::allocate(MemType.getLimit().getMin());
+    if (is64()) {
+      // The 64-bit memory is reserved up to its maximum size without the
+      // guard region, and the accesses are checked explicitly.
+      uint32_t Reserve = std::min(PageLimit, kMax64ReservePages);
+      if (MemType.getLimit().hasMax()) {
+        Reserve = std::min(Reserve, MemType.getLimit().getMax());
+      }
+      AllocPolicy.ReservePages =
+          std::max(Reserve, MemType.getLimit().getMin());
+    }
+    DataPtr = Allocator::allocate(MemType.getLimit().getMin(), AllocPolicy);
     if (DataPtr == nullptr) {
       spdlog::error("Memory Instance: Unable to find usable memory address.");
       MemType.getLimit().setMin(0U);
       return;
     }
+    CommittedPages = MemType.getLimit().getMin();
   }
   ~MemoryInstance() noexcept {
-    Allocator::release(DataPtr, MemType.getLimit().getMin());
+    Allocator::release(DataPtr, CommittedPages, AllocPolicy);
   }
 
   bool isShared() const noexcept { return MemType.getLimit().isShared(); }
 
+  /// Check the memory is indexed with the 64-bit addresses.
+  bool is64() const noexcept { return MemType.getLimit().is64(); }
+
   /// Get page size of memory.data
   uint32_t getPageSize() const noexcept {
     // The memory page size is binded with the limit in memory type.
@@ -75,26 +95,38 @@ public:
   const AST::MemoryType &getMemoryType() const noexcept { return MemType; }
 
   /// Check access size is valid.
-  bool checkAccessBound(uint32_t Offset, uint32_t Length) const noexcept {
-    const uint64_t AccessLen =
-        static_cast<uint64_t>(Offset) + static_cast<uint64_t>(Length);
-    return AccessLen <= MemType.getLimit().getMin() * kPageSize;
+  bool checkAccessBound(uint64_t Offset, uint64_t Length) const noexcept {
+    const uint64_t Size = MemType.getLimit().getMin() * kPageSize;
+    return Length <= Size && Offset <= Size - Length;
   }
 
   /// Get boundary index.
-  uint32_t getBoundIdx() const noexcept {
+  uint64_t getBoundIdx() const noexcept {
     return MemType.getLimit().getMin() > 0
                ? MemType.getLimit().getMin() * kPageSize - 1
                : 0;
   }
 
+  /// Commit the pages exactly to the memory size from now on. The accesses
+  /// beyond the memory size fault on the guard pages after this, which is
+  /// required by the compiled code and the guard page checked interpreter.
+  void setExactCommit() noexcept {
+    AllocPolicy.GrowthMode = Allocator::Growth::Exact;
+    const uint32_t Min = MemType.getLimit().getMin();
+    if (CommittedPages > Min &&
+        Allocator::shrink(DataPtr, CommittedPages, Min)) {
+      CommittedPages = Min;
+    }
+  }
+
   /// Grow page
   bool growPage(const uint32_t Count) {
     if (Count == 0) {
       return true;
     }
-    // Maximum pages count, 65536
-    uint32_t MaxPageCaped = k4G / kPageSize;
+    // Maximum pages count, 65536 or the reserved pages of the 64-bit memory.
+    uint32_t MaxPageCaped = is64() ? AllocPolicy.ReservePages
+                                   : static_cast<uint32_t>(k4G / kPageSize);
     uint32_t Min = MemType.getLimit().getMin();
     assuming(MaxPageCaped >= Min);
     if (MemType.getLimit().hasMax()) {
@@ -112,18 +144,27 @@ public:
                     PageLimit);
       return false;
     }
-    if (auto NewPtr = Allocator::resize(DataPtr, Min, Min + Count);
-        NewPtr == nullptr) {
-      return false;
-    } else {
-      DataPtr = NewPtr;
+    const uint32_t NewMin = Min + Count;
+    if (NewMin > CommittedPages) {
+      // Commit the pages with the growth headroom. The headroom is bounded by
+      // the maximum pages and is invisible to the memory size.
+      const uint32_t Target =
+          getCommitTarget(NewMin, std::min(MaxPageCaped, PageLimit));
+      if (auto NewPtr =
+              Allocator::resize(DataPtr, CommittedPages, Target, AllocPolicy);
+          NewPtr == nullptr) {
+        return false;
+      } else {
+        DataPtr = NewPtr;
+      }
+      CommittedPages = Target;
     }
-    MemType.getLimit().setMin(Min + Count);
+    MemType.getLimit().setMin(NewMin);
     return true;
   }
 
   /// Get slice of Data[Offset : Offset + Length - 1]
-  Expect<Span<Byte>> getBytes(uint32_t Offset, uint32_t Length) const noexcept {
+  Expect<Span<Byte>> getBytes(uint64_t Offset, uint64_t Length) const noexcept {
     // Check the memory boundary.
     if (unlikely(!checkAccessBound(Offset, Length))) {
       spdlog::error(ErrCode::Value::MemoryOutOfBounds);
@@ -134,8 +175,8 @@ public:
   }
 
   /// Replace the bytes of Data[Offset :] by Slice[Start : Start + Length - 1]
-  Expect<void> setBytes(Span<const Byte> Slice, uint32_t Offset, uint32_t Start,
-                        uint32_t Length) noexcept {
+  Expect<void> setBytes(Span<const Byte> Slice, uint64_t Offset, uint64_t Start,
+                        uint64_t Length) noexcept {
     // Check the memory boundary.
     if (unlikely(!checkAccessBound(Offset, Length))) {
       spdlog::error(ErrCode::Value::MemoryOutOfBounds);
@@ -144,24 +185,20 @@ public:
     }
 
     // Check the input data validation.
-    if (unlikely(static_cast<uint64_t>(Start) + static_cast<uint64_t>(Length) >
-                 Slice.size())) {
+    if (unlikely(Length > Slice.size() || Start > Slice.size() - Length)) {
       spdlog::error(ErrCode::Value::MemoryOutOfBounds);
       spdlog::error(ErrInfo::InfoBoundary(Offset, Length, getBoundIdx()));
       return Unexpect(ErrCode::Value::MemoryOutOfBounds);
     }
 
-    // Copy the data.
-    if (likely(Length > 0)) {
-      std::copy(Slice.begin() + Start, Slice.begin() + Start + Length,
-                DataPtr + Offset);
-    }
+    // Copy the data. The regions can overlap in memory.copy.
+    BulkMemory::copy(DataPtr + Offset, Slice.data() + Start, Length);
     return {};
   }
 
   /// Fill the bytes of Data[Offset : Offset + Length - 1] by Val.
-  Expect<void> fillBytes(uint8_t Val, uint32_t Offset,
-                         uint32_t Length) noexcept {
+  Expect<void> fillBytes(uint8_t Val, uint64_t Offset,
+                         uint64_t Length) noexcept {
     // Check the memory boundary.
     if (unlikely(!checkAccessBound(Offset, Length))) {
       spdlog::error(ErrCode::Value::MemoryOutOfBounds);
@@ -169,10 +206,8 @@ public:
       return Unexpect(ErrCode::Value::MemoryOutOfBounds);
     }
 
-    // Copy the data.
-    if (likely(Length > 0)) {
-      std::fill(DataPtr + Offset, DataPtr + Offset + Length, Val);
-    }
+    // Fill the data.
+    BulkMemory::fill(DataPtr + Offset, Val, Length);
     return {};
   }
 
@@ -230,7 +265,7 @@ public:
   /// Get pointer to specific offset of memory.
   template <typename T>
   typename std::enable_if_t<std::is_pointer_v<T>, T>
-  getPointer(uint32_t Offset) const noexcept {
+  getPointer(uint64_t Offset) const noexcept {
     using Type = std::remove_pointer_t<T>;
     uint32_t ByteSize = static_cast<uint32_t>(sizeof(Type));
     if (unlikely(!checkAccessBound(Offset, ByteSize))) {
@@ -270,7 +305,7 @@ public:
   /// \returns void when success, ErrCode when failed.
   template <typename T, uint32_t Length = sizeof(T)>
   typename std::enable_if_t<IsWasmNumV<T>, Expect<void>>
-  loadValue(T &Value, uint32_t Offset) const noexcept {
+  loadValue(T &Value, uint64_t Offset) const noexcept {
     // Check the data boundary.
     static_assert(Length <= sizeof(T));
     // Check the memory boundary.
@@ -284,6 +319,70 @@ public:
       return Unexpect(ErrCode::Value::MemoryOutOfBounds);
     }
     // Load the data to the value.
+    unsafeLoadValue<T, Length>(Value, Offset);
+    return {};
+  }
+
+  /// Template of loading bytes and convert to a value without the boundary
+  /// checking. Only for the guarded memory, and the caller should handle the
+  /// memory fault of the out-of-bound access in the guard region.
+  template <typename T, uint32_t Length = sizeof(T)>
+  typename std::enable_if_t<IsWasmNumV<T>, void>
+  loadValueGuarded(T &Value, uint64_t Offset) const noexcept {
+    static_assert(Length <= sizeof(T));
+    assuming(isGuarded());
+    unsafeLoadValue<T, Length>(Value, Offset);
+  }
+
+  /// Template of loading bytes and convert to a value.
+  ///
+  /// Destruct and Store the value to length of vector.
+  /// Only input value of uint32, uint64, float, and double are allowed.
+  ///
+  /// \param Value the value want to store into data array.
+  /// \param Offset the start offset in data array.
+  ///
+  /// \returns void when success, ErrCode when failed.
+  template <typename T, uint32_t Length = sizeof(T)>
+  typename std::enable_if_t<IsWasmNativeNumV<T>, Expect<void>>
+  storeValue(const T &Value, uint64_t Offset) noexcept {
+    // Check the data boundary.
+    static_assert(Length <= sizeof(T));
+    // Check the memory boundary.
+    if (unlikely(!checkAccessBound(Offset, Length))) {
+      spdlog::error(ErrCode::Value::MemoryOutOfBounds);
+      spdlog::error(ErrInfo::InfoBoundary(Offset, Length, getBoundIdx()));
+      return Unexpect(ErrCode::Value::MemoryOutOfBounds);
+    }
+    // Copy the stored data to the value.
+    unsafeStoreValue<T, Length>(Value, Offset);
+    return {};
+  }
+
+  /// Template of storing a value into bytes without the boundary checking.
+  /// Only for the guarded memory, and the caller should handle the memory
+  /// fault of the out-of-bound access in the guard region.
+  template <typename T, uint32_t Length = sizeof(T)>
+  typename std::enable_if_t<IsWasmNativeNumV<T>, void>
+  storeValueGuarded(const T &Value, uint64_t Offset) noexcept {
+    static_assert(Length <= sizeof(T));
+    assuming(isGuarded());
+    unsafeStoreValue<T, Length>(Value, Offset);
+  }
+
+  /// Check the memory is reserved with the guard region. Any access with a
+  /// 32-bit address and a 32-bit offset beyond the memory size faults in the
+  /// guard region. The 64-bit memories are never guarded.
+  bool isGuarded() const noexcept {
+    return Allocator::kHasGuardRegion && DataPtr != nullptr && !is64();
+  }
+
+  uint8_t *getDataPtr() const noexcept { return DataPtr; }
+
+private:
+  /// Load the value from Data[Offset : Offset + Length - 1] without checking.
+  template <typename T, uint32_t Length>
+  void unsafeLoadValue(T &Value, uint64_t Offset) const noexcept {
     if (likely(Length > 0)) {
       if constexpr (std::is_floating_point_v<T>) {
         // Floating case. Do the memory copy.
@@ -307,44 +406,42 @@ public:
         }
       }
     }
-    return {};
   }
 
-  /// Template of loading bytes and convert to a value.
-  ///
-  /// Destruct and Store the value to length of vector.
-  /// Only input value of uint32, uint64, float, and double are allowed.
-  ///
-  /// \param Value the value want to store into data array.
-  /// \param Offset the start offset in data array.
-  ///
-  /// \returns void when success, ErrCode when failed.
-  template <typename T, uint32_t Length = sizeof(T)>
-  typename std::enable_if_t<IsWasmNativeNumV<T>, Expect<void>>
-  storeValue(const T &Value, uint32_t Offset) noexcept {
-    // Check the data boundary.
-    static_assert(Length <= sizeof(T));
-    // Check the memory boundary.
-    if (unlikely(!checkAccessBound(Offset, Length))) {
-      spdlog::error(ErrCode::Value::MemoryOutOfBounds);
-      spdlog::error(ErrInfo::InfoBoundary(Offset, Length, getBoundIdx()));
-      return Unexpect(ErrCode::Value::MemoryOutOfBounds);
-    }
-    // Copy the stored data to the value.
+  /// Store the value to Data[Offset : Offset + Length - 1] without checking.
+  template <typename T, uint32_t Length>
+  void unsafeStoreValue(const T &Value, uint64_t Offset) noexcept {
     if (likely(Length > 0)) {
       std::memcpy(&DataPtr[Offset], &Value, Length);
     }
-    return {};
   }
 
-  uint8_t *getDataPtr() const noexcept { return DataPtr; }
+  /// Get the committed page count for growing to `NewMin` pages.
+  uint32_t getCommitTarget(uint32_t NewMin, uint32_t Cap) const noexcept {
+    const uint64_t Step = std::max(AllocPolicy.GrowthStepPages, UINT32_C(1));
+    uint64_t Target = NewMin;
+    switch (AllocPolicy.GrowthMode) {
+    case Allocator::Growth::Fixed:
+      Target = (Target + Step - 1) / Step * Step;
+      break;
+    case Allocator::Growth::Geometric:
+      Target = std::max(Target, static_cast<uint64_t>(CommittedPages) * 2);
+      Target = std::max(Target, CommittedPages + Step);
+      break;
+    default:
+      break;
+    }
+    return static_cast<uint32_t>(std::min(Target, static_cast<uint64_t>(Cap)));
+  }
 
-private:
   /// \name Data of memory instance.
   /// @{
   AST::MemoryType MemType;
   uint8_t *DataPtr = nullptr;
   const uint32_t PageLimit;
+  Allocator::Policy AllocPolicy;
+  /// Committed pages, which are not less than the memory size.
+  uint32_t CommittedPages = 0;
   /// @}
 };
 
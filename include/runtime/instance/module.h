@@ -45,6 +45,10 @@ namespace Executor {
 class Executor;
 }
 
+namespace VM {
+class TierUpCompiler;
+}
+
 namespace Runtime {
 
 class StoreManager;
@@ -253,6 +257,7 @@ protected:
   friend class ComponentInstance;
   friend class Runtime::CallingFrame;
   friend class Runtime::SerializationManager;
+  friend class VM::TierUpCompiler;
 
   /// Create and copy the defined type to this module instance.
   void addDefinedType(const AST::SubType &SType) {
@@ -18,6 +18,7 @@
 #include "common/errcode.h"
 #include "common/errinfo.h"
 #include "common/spdlog.h"
+#include "system/bulkmem.h"
 
 #include <algorithm>
 #include <cstdint>
@@ -117,15 +118,11 @@ public:
       return Unexpect(ErrCode::Value::TableOutOfBounds);
     }
 
-    // Copy the references.
-    if (Dst <= Src) {
-      std::copy(Slice.begin() + Src, Slice.begin() + Src + Length,
-                Refs.begin() + Dst);
-    } else {
-      std::copy(std::make_reverse_iterator(Slice.begin() + Src + Length),
-                std::make_reverse_iterator(Slice.begin() + Src),
-                std::make_reverse_iterator(Refs.begin() + Dst + Length));
-    }
+    // Copy the references. The regions can overlap in table.copy.
+    static_assert(std::is_trivially_copyable_v<RefVariant>);
+    BulkMemory::copy(reinterpret_cast<uint8_t *>(Refs.data() + Dst),
+                     reinterpret_cast<const uint8_t *>(Slice.data() + Src),
+                     static_cast<uint64_t>(Length) * sizeof(RefVariant));
     return {};
   }
 
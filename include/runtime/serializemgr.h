@@ -255,11 +255,11 @@ private:
         uint32_t StackSize = StackMgr->size();
         OA << StackSize;
         for (uint32_t i = 0; i < StackSize; i++) {
-            save_value(OA, StackMgr->ValueStack[i]);
+            save_value(OA, StackMgr->ValueBase[i]);
         }
 
         // for (uint32_t i = 0; i < StackSize; i++) {
-        //     std::cerr << StackMgr->ValueStack[i].get<uint64_t>() << " ";
+        //     std::cerr << StackMgr->ValueBase[i].get<uint64_t>() << " ";
         // }
         // std::cerr << "\n";
 
@@ -275,10 +275,11 @@ private:
             //           << "]" << std::endl;
         }
 
-        StackSize = StackMgr->FrameStack.size();
+        StackSize =
+            static_cast<uint32_t>(StackMgr->FrameTop - StackMgr->FrameBase);
         OA << StackSize;
         for (uint32_t i = 2; i < StackSize; i++) {
-            Frame frame = StackMgr->FrameStack[i];
+            Frame frame = StackMgr->FrameBase[i];
             OA << frame.Locals << frame.Arity << frame.VPos;
 
             Pointer P = frame.From;
@@ -309,13 +310,13 @@ private:
     void load_stack(InputArchive &IA, Pointer &PC, const Function *&F) {
         uint32_t StackSize;
         IA >> StackSize;
-        StackMgr->ValueStack.resize(StackSize);
+        StackMgr->ValueTop = StackMgr->ValueBase + StackSize;
         for (uint32_t i = 0; i < StackSize; i++) {
-            StackMgr->ValueStack[i] = load_value(IA);
+            StackMgr->ValueBase[i] = load_value(IA);
         }
 
         // for (uint32_t i = 0; i < StackSize; i++) {
-        //     std::cerr << StackMgr->ValueStack[i].get<uint64_t>() << " ";
+        //     std::cerr << StackMgr->ValueBase[i].get<uint64_t>() << " ";
         // }
         // std::cerr << "\n";
 
@@ -327,8 +328,8 @@ private:
             uint32_t VPos;
             IA >> Locals >> Arity >> VPos;
             From = load_pointer(IA);
-            Frame frame(ModInst, From, Locals, Arity, VPos);
-            StackMgr->FrameStack.push_back(frame);
+            Frame frame(ModInst, From, Locals, Arity, VPos, 0, nullptr);
+            *StackMgr->FrameTop++ = frame;
         }
 
         load_pointer(IA, PC, F);
@@ -15,8 +15,13 @@
 
 #include "ast/instruction.h"
 #include "runtime/instance/module.h"
+#include "system/allocator.h"
 
+#include <algorithm>
+#include <cstdint>
+#include <new>
 #include <optional>
+#include <type_traits>
 #include <vector>
 
 namespace WasmEdge {
@@ -38,185 +43,281 @@ public:
   struct Frame {
     Frame() = delete;
     Frame(const Instance::ModuleInstance *Mod, AST::InstrView::iterator FromIt,
-          uint32_t L, uint32_t A, uint32_t V) noexcept
-        : Module(Mod), From(FromIt), Locals(L), Arity(A), VPos(V) {}
+          uint32_t L, uint32_t A, uint32_t V, uint32_t H,
+          const Instance::FunctionInstance *F) noexcept
+        : Module(Mod), From(FromIt), Locals(L), Arity(A), VPos(V), HPos(H),
+          Func(F) {}
     const Instance::ModuleInstance *Module;
     AST::InstrView::iterator From;
     uint32_t Locals;
     uint32_t Arity;
     uint32_t VPos;
-    std::vector<Handler> HandlerStack;
+    /// Start of the handlers of this frame in the handler stack.
+    uint32_t HPos;
+    /// The interpreted function of this frame, or nullptr for the others.
+    const Instance::FunctionInstance *Func;
   };
 
+  /// Capacities of the value stack, the frame stack, and the handler stack.
+  static inline constexpr const uint32_t kValueStackSize = UINT32_C(1) << 20;
+  static inline constexpr const uint32_t kFrameStackSize = UINT32_C(1) << 17;
+  static inline constexpr const uint32_t kHandlerStackSize = UINT32_C(1) << 14;
+  /// Value entries kept free for the operands when pushing a frame.
+  static inline constexpr const uint32_t kFrameHeadroom = UINT32_C(1) << 14;
+
   /// Stack manager provides the stack control for Wasm execution with VALIDATED
   /// modules. All operations of instructions passed validation, therefore no
   /// unexpect operations will occur.
+  ///
+  /// The three stacks are placed in a single region in the order of frames,
+  /// handlers, and values, and the value stack is followed by a guard page.
+  /// The pushing and popping only bump the top pointers. The capacity of a new
+  /// frame is checked by `hasCapacity()`, and the operands beyond the headroom
+  /// fault in the guard page instead of overwriting the memory.
   StackManager() noexcept {
-    ValueStack.reserve(2048U);
-    FrameStack.reserve(16U);
+    Region = Allocator::allocate_stack(kRegionSize);
+    if (unlikely(Region == nullptr)) {
+      // Leave all the stacks in zero capacity.
+      return;
+    }
+    FrameBase = FrameTop = reinterpret_cast<Frame *>(Region);
+    FrameLimit = FrameBase + kFrameStackSize;
+    HandlerBase = HandlerTop =
+        reinterpret_cast<Handler *>(Region + kFrameStackBytes);
+    HandlerLimit = HandlerBase + kHandlerStackSize;
+    ValueBase = ValueTop = reinterpret_cast<Value *>(
+        Region + kFrameStackBytes + kHandlerStackBytes);
+    ValueLimit = ValueBase + kValueStackSize;
   }
-  ~StackManager() = default;
+  StackManager(const StackManager &) = delete;
+  StackManager &operator=(const StackManager &) = delete;
+  ~StackManager() noexcept { Allocator::release_stack(Region, kRegionSize); }
 
   /// Getter of stack size.
-  size_t size() const noexcept { return ValueStack.size(); }
+  size_t size() const noexcept {
+    return static_cast<size_t>(ValueTop - ValueBase);
+  }
+
+  /// Check whether a new frame with the N value entries, such as the local
+  /// variables, can be pushed with the headroom left. The tail calls reuse the
+  /// current frame.
+  bool hasCapacity(uint32_t N, bool IsTailCall = false) const noexcept {
+    return (IsTailCall || FrameTop != FrameLimit) &&
+           static_cast<uint64_t>(ValueLimit - ValueTop) >=
+               static_cast<uint64_t>(N) + kFrameHeadroom;
+  }
 
   /// Unsafe getter of top entry of stack.
-  Value &getTop() { return ValueStack.back(); }
+  Value &getTop() noexcept { return *(ValueTop - 1); }
 
   /// Unsafe getter of top N-th value entry of stack.
   Value &getTopN(uint32_t Offset) noexcept {
-    assuming(0 < Offset && Offset <= ValueStack.size());
-    return ValueStack[ValueStack.size() - Offset];
+    assuming(0 < Offset && Offset <= size());
+    return *(ValueTop - Offset);
   }
 
   /// Unsafe getter of top N value entries of stack.
-  Span<Value> getTopSpan(uint32_t N) {
-    return Span<Value>(ValueStack.end() - N, N);
+  Span<Value> getTopSpan(uint32_t N) noexcept {
+    return Span<Value>(ValueTop - N, N);
   }
 
   /// Push a new value entry to stack.
-  template <typename T> void push(T &&Val) {
-    ValueStack.push_back(std::forward<T>(Val));
+  template <typename T> void push(T &&Val) noexcept {
+    new (ValueTop++) Value(std::forward<T>(Val));
   }
 
   /// Push a vector of value to stack
-  void pushValVec(const std::vector<Value> &ValVec) {
-    ValueStack.insert(ValueStack.end(), ValVec.begin(), ValVec.end());
+  void pushValVec(const std::vector<Value> &ValVec) noexcept {
+    ValueTop = std::copy(ValVec.begin(), ValVec.end(), ValueTop);
   }
 
-  /// Unsafe pop and return the top entry.
-  Value pop() {
-    Value V = std::move(ValueStack.back());
-    ValueStack.pop_back();
-    return V;
+  /// Push N value entries to stack and return the span of them. The span will
+  /// be invalidated by the following popping.
+  Span<Value> pushSpan(uint32_t N) noexcept {
+    std::fill_n(ValueTop, N, Value());
+    ValueTop += N;
+    return Span<Value>(ValueTop - N, N);
   }
 
+  /// Unsafe pop and return the top entry.
+  Value pop() noexcept { return *--ValueTop; }
+
   /// Unsafe pop and return the top N entries.
   std::vector<Value> pop(uint32_t N) {
-    std::vector<Value> Vec;
-    Vec.reserve(N);
-    std::move(ValueStack.end() - N, ValueStack.end(), std::back_inserter(Vec));
-    ValueStack.erase(ValueStack.end() - N, ValueStack.end());
+    std::vector<Value> Vec(ValueTop - N, ValueTop);
+    ValueTop -= N;
     return Vec;
   }
 
-  /// Push a new frame entry to stack.
+  /// Push a new frame entry to stack. The capacity should be checked by
+  /// `hasCapacity()` first.
   void pushFrame(const Instance::ModuleInstance *Module,
                  AST::InstrView::iterator From, uint32_t LocalNum = 0,
-                 uint32_t Arity = 0, bool IsTailCall = false) noexcept {
+                 uint32_t Arity = 0, bool IsTailCall = false,
+                 const Instance::FunctionInstance *Func = nullptr) noexcept {
     if (!IsTailCall) {
-      FrameStack.emplace_back(Module, From, LocalNum, Arity,
-                              static_cast<uint32_t>(ValueStack.size()));
+      assuming(FrameTop != FrameLimit);
+      new (FrameTop++) Frame(Module, From, LocalNum, Arity,
+                             static_cast<uint32_t>(size()), getHandlerPos(),
+                             Func);
     } else {
-      assuming(!FrameStack.empty());
-      assuming(FrameStack.back().VPos >= FrameStack.back().Locals);
-      assuming(FrameStack.back().VPos - FrameStack.back().Locals <=
-               ValueStack.size() - LocalNum);
-      ValueStack.erase(ValueStack.begin() + FrameStack.back().VPos -
-                           FrameStack.back().Locals,
-                       ValueStack.end() - LocalNum);
-      FrameStack.back().Module = Module;
-      FrameStack.back().Locals = LocalNum;
-      FrameStack.back().Arity = Arity;
-      FrameStack.back().VPos = static_cast<uint32_t>(ValueStack.size());
-      FrameStack.back().HandlerStack.clear();
+      assuming(FrameTop != FrameBase);
+      Frame &Top = *(FrameTop - 1);
+      assuming(Top.VPos >= Top.Locals);
+      assuming(Top.VPos - Top.Locals <= size() - LocalNum);
+      keepTopValues(ValueBase + Top.VPos - Top.Locals, LocalNum);
+      Top.Module = Module;
+      Top.Func = Func;
+      Top.Locals = LocalNum;
+      Top.Arity = Arity;
+      Top.VPos = static_cast<uint32_t>(size());
+      HandlerTop = HandlerBase + Top.HPos;
     }
   }
 
   /// Unsafe pop top frame.
   AST::InstrView::iterator popFrame() noexcept {
-    assuming(!FrameStack.empty());
-    assuming(FrameStack.back().VPos >= FrameStack.back().Locals);
-    assuming(FrameStack.back().VPos - FrameStack.back().Locals <=
-             ValueStack.size() - FrameStack.back().Arity);
-    ValueStack.erase(ValueStack.begin() + FrameStack.back().VPos -
-                         FrameStack.back().Locals,
-                     ValueStack.end() - FrameStack.back().Arity);
-    auto From = FrameStack.back().From;
-    FrameStack.pop_back();
-    return From;
-  }
-
-  /// Push handler for try-catch block.
-  void
+    assuming(FrameTop != FrameBase);
+    const Frame &Top = *--FrameTop;
+    assuming(Top.VPos >= Top.Locals);
+    assuming(Top.VPos - Top.Locals <= size() - Top.Arity);
+    keepTopValues(ValueBase + Top.VPos - Top.Locals, Top.Arity);
+    HandlerTop = HandlerBase + Top.HPos;
+    return Top.From;
+  }
+
+  /// Push handler for try-catch block. Returns false if the handler stack is
+  /// exhausted.
+  bool
   pushHandler(AST::InstrView::iterator TryIt, uint32_t BlockParamNum,
               Span<const AST::Instruction::CatchDescriptor> Catch) noexcept {
-    assuming(!FrameStack.empty());
-    FrameStack.back().HandlerStack.emplace_back(
-        TryIt, static_cast<uint32_t>(ValueStack.size()) - BlockParamNum, Catch);
+    assuming(FrameTop != FrameBase);
+    if (unlikely(HandlerTop == HandlerLimit)) {
+      return false;
+    }
+    new (HandlerTop++)
+        Handler(TryIt, static_cast<uint32_t>(size()) - BlockParamNum, Catch);
+    return true;
   }
 
   /// Pop the top handler on the stack.
   std::optional<Handler> popTopHandler(uint32_t AssocValSize) noexcept {
-    while (!FrameStack.empty()) {
-      auto &Frame = FrameStack.back();
-      if (!Frame.HandlerStack.empty()) {
-        auto TopHandler = std::move(Frame.HandlerStack.back());
-        Frame.HandlerStack.pop_back();
-        assuming(TopHandler.VPos <= ValueStack.size() - AssocValSize);
-        ValueStack.erase(ValueStack.begin() + TopHandler.VPos,
-                         ValueStack.end() - AssocValSize);
+    while (FrameTop != FrameBase) {
+      if (HandlerTop != HandlerBase + (FrameTop - 1)->HPos) {
+        const Handler TopHandler = *--HandlerTop;
+        assuming(TopHandler.VPos <= size() - AssocValSize);
+        keepTopValues(ValueBase + TopHandler.VPos, AssocValSize);
         return TopHandler;
       }
-      FrameStack.pop_back();
+      --FrameTop;
     }
     return std::nullopt;
   }
 
   /// Unsafe remove inactive handler.
   void removeInactiveHandler(AST::InstrView::iterator PC) noexcept {
-    assuming(!FrameStack.empty());
+    assuming(FrameTop != FrameBase);
     // First pop the inactive handlers. Br instructions may cause the handlers
     // in current frame becomes inactive.
-    auto &HandlerStack = FrameStack.back().HandlerStack;
-    while (!HandlerStack.empty()) {
-      auto &Handler = HandlerStack.back();
-      if (PC < Handler.Try ||
-          PC > Handler.Try + Handler.Try->getTryCatch().JumpEnd) {
-        HandlerStack.pop_back();
+    Handler *const FrameHandlerBase = HandlerBase + (FrameTop - 1)->HPos;
+    while (HandlerTop != FrameHandlerBase) {
+      const Handler &Top = *(HandlerTop - 1);
+      if (PC < Top.Try || PC > Top.Try + Top.Try->getTryCatch().JumpEnd) {
+        --HandlerTop;
       } else {
         break;
       }
     }
   }
 
-  /// Unsafe erase value stack.
+  /// Unsafe erase value stack. The entries in [Top - EraseBegin, Top -
+  /// EraseEnd) are dropped, where EraseEnd is the result count precomputed in
+  /// the jump descriptor.
   void eraseValueStack(uint32_t EraseBegin, uint32_t EraseEnd) noexcept {
-    assuming(EraseEnd <= EraseBegin && EraseBegin <= ValueStack.size());
-    ValueStack.erase(ValueStack.end() - EraseBegin,
-                     ValueStack.end() - EraseEnd);
+    assuming(EraseEnd <= EraseBegin && EraseBegin <= size());
+    keepTopValues(ValueTop - EraseBegin, EraseEnd);
   }
 
   /// Unsafe leave top label.
   AST::InstrView::iterator
   maybePopFrameOrHandler(AST::InstrView::iterator PC) noexcept {
-    if (FrameStack.size() > 1 && PC->isExprLast()) {
+    if (FrameTop - FrameBase > 1 && PC->isExprLast()) {
       // Noted that there's always a base frame in stack.
       return popFrame();
     }
     if (PC->isTryBlockLast()) {
-      FrameStack.back().HandlerStack.pop_back();
+      --HandlerTop;
     }
     return PC;
   }
 
   /// Unsafe getter of module address.
   const Instance::ModuleInstance *getModule() const noexcept {
-    assuming(!FrameStack.empty());
-    return FrameStack.back().Module;
+    assuming(FrameTop != FrameBase);
+    return (FrameTop - 1)->Module;
+  }
+
+  /// Unsafe getter of the interpreted function of the top frame.
+  const Instance::FunctionInstance *getFunction() const noexcept {
+    assuming(FrameTop != FrameBase);
+    return (FrameTop - 1)->Func;
   }
 
   /// Reset stack.
   void reset() noexcept {
-    ValueStack.clear();
-    FrameStack.clear();
+    ValueTop = ValueBase;
+    FrameTop = FrameBase;
+    HandlerTop = HandlerBase;
   }
 
 private:
+  static_assert(std::is_trivially_copyable_v<Value> &&
+                std::is_trivially_destructible_v<Value>);
+  static_assert(std::is_trivially_copyable_v<Frame> &&
+                std::is_trivially_destructible_v<Frame>);
+  static_assert(std::is_trivially_copyable_v<Handler> &&
+                std::is_trivially_destructible_v<Handler>);
+
+  static inline constexpr const uint64_t kFrameStackBytes =
+      sizeof(Frame) * kFrameStackSize;
+  static inline constexpr const uint64_t kHandlerStackBytes =
+      sizeof(Handler) * kHandlerStackSize;
+  static inline constexpr const uint64_t kRegionSize =
+      kFrameStackBytes + kHandlerStackBytes + sizeof(Value) * kValueStackSize;
+  static_assert((kFrameStackBytes + kHandlerStackBytes) % alignof(Value) == 0);
+
+  /// Getter of the handler stack size.
+  uint32_t getHandlerPos() const noexcept {
+    return static_cast<uint32_t>(HandlerTop - HandlerBase);
+  }
+
+  /// Move the top N value entries, such as the block results, down to Dst and
+  /// drop the entries between. Only the kept entries are copied, and nothing
+  /// is copied if no entry is dropped.
+  void keepTopValues(Value *Dst, uint32_t N) noexcept {
+    Value *const Src = ValueTop - N;
+    if (Dst != Src) {
+      if (N == 1) {
+        *Dst = *Src;
+      } else {
+        std::copy(Src, ValueTop, Dst);
+      }
+    }
+    ValueTop = Dst + N;
+  }
+
   /// \name Data of stack manager.
   /// @{
-  std::vector<Value> ValueStack;
-  std::vector<Frame> FrameStack;
+  uint8_t *Region = nullptr;
+  Value *ValueBase = nullptr;
+  Value *ValueTop = nullptr;
+  Value *ValueLimit = nullptr;
+  Frame *FrameBase = nullptr;
+  Frame *FrameTop = nullptr;
+  Frame *FrameLimit = nullptr;
+  Handler *HandlerBase = nullptr;
+  Handler *HandlerTop = nullptr;
+  Handler *HandlerLimit = nullptr;
   /// @}
 
   friend class Executor::Executor;
@@ -13,6 +13,7 @@
 //===----------------------------------------------------------------------===//
 #pragma once
 
+#include "common/config.h"
 #include "common/defines.h"
 #include <cstdint>
 
@@ -26,14 +27,96 @@ namespace WasmEdge {
 
 class Allocator {
 public:
-  WASMEDGE_EXPORT static uint8_t *allocate(uint32_t PageCount) noexcept;
+  /// Whether the linear memory is reserved in the 12 GiB region with the 4 GiB
+  /// leading guard pages. For such memory, any access with a 32-bit address
+  /// and a 32-bit offset beyond the memory size faults.
+#if WASMEDGE_OS_WINDOWS || defined(HAVE_MMAP) && defined(__x86_64__) ||        \
+    defined(__aarch64__) || (defined(__riscv) && __riscv_xlen == 64)
+  static inline constexpr const bool kHasGuardRegion = true;
+#else
+  static inline constexpr const bool kHasGuardRegion = false;
+#endif
+
+  /// Huge page mode of the linear memory pages.
+  enum class HugePage : uint8_t {
+    /// Normal pages.
+    None,
+    /// Advise the kernel to back the pages with the transparent huge pages.
+    Transparent,
+    /// Back the 2 MiB aligned chunks with the hugetlbfs pages, and fall back
+    /// to the normal pages when no huge page is available.
+    HugeTLB,
+  };
+
+  /// Growth mode of the committed linear memory pages.
+  enum class Growth : uint8_t {
+    /// Commit the grown pages exactly.
+    Exact,
+    /// Commit up to the next multiple of the growth step.
+    Fixed,
+    /// Commit at least double the committed pages, and at least the growth
+    /// step more.
+    Geometric,
+  };
+
+  /// Allocation policy of the linear memory pages.
+  struct Policy {
+    HugePage HugePageMode = HugePage::None;
+    /// Prefer the NUMA node of the allocating thread.
+    bool NUMALocal = false;
+    /// Maximum idle slots in the process-wide slot pool. The released memory
+    /// is recycled into the pool instead of being unmapped. 0 for no pooling.
+    uint32_t PoolSlots = 0;
+    /// Pages kept committed in the recycled slots, which are zeroed on reuse
+    /// instead of being faulted in again.
+    uint32_t KeepResidentPages = 0;
+    /// Commit the pages in chunks when growing. The pages beyond the memory
+    /// size are readable and writable, so this is only valid when every access
+    /// is checked against the memory size.
+    Growth GrowthMode = Growth::Exact;
+    /// Growth step in pages.
+    uint32_t GrowthStepPages = 0;
+    /// Reserve the region of the pages without the guard region instead of
+    /// the 12 GiB region, such as for the 64-bit memories. 0 for the guarded
+    /// 12 GiB region. The pooled slots are not used for such regions.
+    uint32_t ReservePages = 0;
+  };
+
+  static uint8_t *allocate(uint32_t PageCount) noexcept {
+    return allocate(PageCount, Policy());
+  }
+
+  WASMEDGE_EXPORT static uint8_t *allocate(uint32_t PageCount,
+                                           Policy MemPolicy) noexcept;
+
+  static uint8_t *resize(uint8_t *Pointer, uint32_t OldPageCount,
+                         uint32_t NewPageCount) noexcept {
+    return resize(Pointer, OldPageCount, NewPageCount, Policy());
+  }
 
   WASMEDGE_EXPORT static uint8_t *resize(uint8_t *Pointer,
                                          uint32_t OldPageCount,
-                                         uint32_t NewPageCount) noexcept;
+                                         uint32_t NewPageCount,
+                                         Policy MemPolicy) noexcept;
+
+  /// Decommit the pages in [NewPageCount, OldPageCount) back to the reserved
+  /// state.
+  WASMEDGE_EXPORT static bool shrink(uint8_t *Pointer, uint32_t OldPageCount,
+                                     uint32_t NewPageCount) noexcept;
+
+  static void release(uint8_t *Pointer, uint32_t PageCount) noexcept {
+    release(Pointer, PageCount, Policy());
+  }
+
+  WASMEDGE_EXPORT static void release(uint8_t *Pointer, uint32_t PageCount,
+                                      Policy MemPolicy) noexcept;
 
-  WASMEDGE_EXPORT static void release(uint8_t *Pointer,
-                                      uint32_t PageCount) noexcept;
+  /// Allocate a region of Size bytes followed by a guard page, such as for the
+  /// value stacks. The pages are committed on the first access where the
+  /// platform supports it, and any access to the guard page faults.
+  WASMEDGE_EXPORT static uint8_t *allocate_stack(uint64_t Size) noexcept;
+  WASMEDGE_EXPORT static void release_stack(uint8_t *Pointer,
+                                            uint64_t Size) noexcept;
 
   static uint8_t *allocate_chunk(uint64_t Size) noexcept;
   static void release_chunk(uint8_t *Pointer, uint64_t Size) noexcept;
@@ -0,0 +1,125 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2019-2022 Second State INC
+
+//===-- wasmedge/system/bulkmem.h - Bulk memory copy and fill -------------===//
+//
+// Part of the WasmEdge Project.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file contains the size-tiered kernels of the bulk memory operations.
+///
+//===----------------------------------------------------------------------===//
+#pragma once
+
+#include "common/config.h"
+#include "common/defines.h"
+#include <cstdint>
+#include <cstring>
+
+#if WASMEDGE_OS_WINDOWS
+#define WASMEDGE_EXPORT __declspec(dllexport)
+#else
+#define WASMEDGE_EXPORT [[gnu::visibility("default")]]
+#endif
+
+namespace WasmEdge {
+
+/// Kernels of the bulk memory operations in three tiers:
+///
+/// - Small: up to 32 bytes, copied inline with the overlapping unaligned
+///   loads and stores.
+/// - Medium: the C library routines, which already dispatch to the
+///   `rep movsb` and the vector implementations of the CPU.
+/// - Large: from the streaming threshold, the non-temporal stores bypassing
+///   the caches, which avoid evicting the working set on the multi-MB copies.
+///
+/// The source and destination regions of `copy` can overlap.
+class BulkMemory {
+public:
+  /// Maximum bytes of the inline small tier.
+  static inline constexpr const uint64_t kSmallSize = 32;
+
+  /// Copy Src[0 : Len) to Dst[0 : Len).
+  static void copy(uint8_t *Dst, const uint8_t *Src, uint64_t Len) noexcept {
+    if (Len <= kSmallSize) {
+      copySmall(Dst, Src, Len);
+    } else {
+      copyLarge(Dst, Src, Len);
+    }
+  }
+
+  /// Fill Dst[0 : Len) by Val.
+  static void fill(uint8_t *Dst, uint8_t Val, uint64_t Len) noexcept {
+    if (Len <= kSmallSize) {
+      fillSmall(Dst, Val, Len);
+    } else {
+      fillLarge(Dst, Val, Len);
+    }
+  }
+
+  /// Getter and setter of the size in bytes from which the non-temporal
+  /// stores are used. Defaults to the last level cache size.
+  WASMEDGE_EXPORT static uint64_t getStreamingThreshold() noexcept;
+  WASMEDGE_EXPORT static void setStreamingThreshold(uint64_t Size) noexcept;
+
+private:
+  WASMEDGE_EXPORT static void copyLarge(uint8_t *Dst, const uint8_t *Src,
+                                        uint64_t Len) noexcept;
+  WASMEDGE_EXPORT static void fillLarge(uint8_t *Dst, uint8_t Val,
+                                        uint64_t Len) noexcept;
+
+  /// Copy the small sizes. All the loads are done before the stores, so the
+  /// overlapping regions are handled.
+  static void copySmall(uint8_t *Dst, const uint8_t *Src,
+                        uint64_t Len) noexcept {
+    if (Len >= 16) {
+      uint64_t A[2], B[2];
+      std::memcpy(A, Src, 16);
+      std::memcpy(B, Src + Len - 16, 16);
+      std::memcpy(Dst, A, 16);
+      std::memcpy(Dst + Len - 16, B, 16);
+    } else if (Len >= 8) {
+      uint64_t A, B;
+      std::memcpy(&A, Src, 8);
+      std::memcpy(&B, Src + Len - 8, 8);
+      std::memcpy(Dst, &A, 8);
+      std::memcpy(Dst + Len - 8, &B, 8);
+    } else if (Len >= 4) {
+      uint32_t A, B;
+      std::memcpy(&A, Src, 4);
+      std::memcpy(&B, Src + Len - 4, 4);
+      std::memcpy(Dst, &A, 4);
+      std::memcpy(Dst + Len - 4, &B, 4);
+    } else if (Len > 0) {
+      const uint8_t A = Src[0], B = Src[Len / 2], C = Src[Len - 1];
+      Dst[0] = A;
+      Dst[Len / 2] = B;
+      Dst[Len - 1] = C;
+    }
+  }
+
+  /// Fill the small sizes with the overlapping stores.
+  static void fillSmall(uint8_t *Dst, uint8_t Val, uint64_t Len) noexcept {
+    const uint64_t V = UINT64_C(0x0101010101010101) * Val;
+    if (Len >= 16) {
+      std::memcpy(Dst, &V, 8);
+      std::memcpy(Dst + 8, &V, 8);
+      std::memcpy(Dst + Len - 16, &V, 8);
+      std::memcpy(Dst + Len - 8, &V, 8);
+    } else if (Len >= 8) {
+      std::memcpy(Dst, &V, 8);
+      std::memcpy(Dst + Len - 8, &V, 8);
+    } else if (Len >= 4) {
+      std::memcpy(Dst, &V, 4);
+      std::memcpy(Dst + Len - 4, &V, 4);
+    } else if (Len > 0) {
+      Dst[0] = Val;
+      Dst[Len / 2] = Val;
+      Dst[Len - 1] = Val;
+    }
+  }
+};
+
+} // namespace WasmEdge
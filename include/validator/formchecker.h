@@ -58,6 +58,12 @@ public:
   auto &getFunctions() { return Funcs; }
   auto &getTables() { return Tables; }
   auto &getMemories() { return Mems; }
+  /// Getter of the address type of the memory, which is i64 for the 64-bit
+  /// memories in memory64 proposal.
+  ValType getMemoryAddrType(uint32_t Idx) const noexcept {
+    return Idx < MemAddrTypes.size() ? MemAddrTypes[Idx]
+                                     : ValType(TypeCode::I32);
+  }
   auto &getGlobals() { return Globals; }
   auto &getTags() { return Tags; }
   uint32_t getNumImportFuncs() const { return NumImportFuncs; }
@@ -130,6 +136,7 @@ private:
   std::vector<uint32_t> Funcs;
   std::vector<ValType> Tables;
   uint32_t Mems = 0;
+  std::vector<ValType> MemAddrTypes;
   std::vector<std::pair<ValType, ValMut>> Globals;
   std::vector<ValType> Elems;
   std::vector<uint32_t> Datas;
@@ -78,6 +78,8 @@ private:
   const Configure Conf;
   /// Formal checker
   FormChecker Checker;
+  /// Module context of formal checker for the lazy function bodies
+  std::shared_ptr<const FormChecker> LazyContext;
 };
 
 } // namespace Validator
@@ -0,0 +1,66 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2019-2022 Second State INC
+
+//===-- wasmedge/vm/tierup.h - Tiered execution compiler definition -------===//
+//
+// Part of the WasmEdge Project.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file is the definition class of the background compiler for the tiered
+/// execution.
+///
+//===----------------------------------------------------------------------===//
+#pragma once
+
+#include "ast/module.h"
+#include "common/configure.h"
+#include "common/threadpool.h"
+#include "runtime/instance/module.h"
+
+#include <atomic>
+#include <cstdint>
+
+namespace WasmEdge {
+namespace VM {
+
+/// Compile the hot functions of a module instance one by one in a background
+/// thread for the tiered execution. The compiled code is set into the function
+/// instances, and the later calls of them run the compiled code.
+class TierUpCompiler {
+public:
+  TierUpCompiler(const Configure &Conf, const AST::Module &Mod) noexcept;
+  /// Drop the queued functions and wait for the compiling one.
+  ~TierUpCompiler() noexcept;
+
+  /// Check the functions of the module can be compiled one by one.
+  static bool isSupported(const Configure &Conf,
+                          const AST::Module &Mod) noexcept;
+
+  /// Setter of the module instance instantiated from the module. Only the
+  /// functions of it are compiled.
+  void setModule(const Runtime::Instance::ModuleInstance *Inst) noexcept {
+    ModInst.store(Inst, std::memory_order_release);
+  }
+
+  /// Queue the hot function for compiling.
+  void submit(const Runtime::Instance::FunctionInstance &Func);
+
+private:
+  /// Compile the function and set the compiled code into it.
+  void compile(const Runtime::Instance::FunctionInstance &Func) noexcept;
+
+  const Configure Conf;
+  const AST::Module &Mod;
+  std::atomic<const Runtime::Instance::ModuleInstance *> ModInst = nullptr;
+  /// Imported function count, the offset of the defined functions.
+  uint32_t ImportFuncNum = 0;
+  std::atomic<bool> Stopped = false;
+  /// The compiling thread. Declared last to join it before destructing the
+  /// other members.
+  ThreadPool Pool;
+};
+
+} // namespace VM
+} // namespace WasmEdge
@@ -25,6 +25,7 @@
 
 #include "runtime/instance/module.h"
 #include "runtime/storemgr.h"
+#include "vm/tierup.h"
 
 #include <cstdint>
 #include <memory>
@@ -255,6 +256,16 @@ private:
 
   void unsafeCleanup();
 
+  /// Stop the tiered execution of the active module instance. Must be called
+  /// before the loaded module or the active module instance is replaced.
+  void unsafeStopTierUp();
+
+  /// Load the WASM module with the compiled code from the AOT cache, and
+  /// compile and publish it into the cache on a miss. Return nullptr for the
+  /// other data, which are loaded as usual.
+  Expect<std::unique_ptr<AST::Module>>
+  unsafeLoadCachedModule(Span<const Byte> Code);
+
   std::vector<std::pair<std::string, const AST::FunctionType &>>
   unsafeGetFunctionList() const;
 
@@ -320,6 +331,9 @@ private:
   std::unique_ptr<Runtime::StoreManager> Store;
   /// Reference to the store.
   Runtime::StoreManager &StoreRef;
+  /// Background compiler of the active module instance in the tiered
+  /// execution. Declared last to stop it before destructing the module.
+  std::unique_ptr<TierUpCompiler> TierUp;
   /// @}
 };
 
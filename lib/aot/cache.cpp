@@ -9,9 +9,18 @@
 #include "common/hexstr.h"
 #include "system/path.h"
 
+#include <algorithm>
 #include <array>
 #include <string>
 #include <system_error>
+#include <tuple>
+#include <vector>
+
+#if WASMEDGE_OS_LINUX || WASMEDGE_OS_MACOS
+#include <fcntl.h>
+#include <sys/file.h>
+#include <unistd.h>
+#endif
 
 namespace WasmEdge {
 namespace AOT {
@@ -35,14 +44,22 @@ std::filesystem::path getRoot(Cache::StorageScope Scope) {
 
 Expect<std::filesystem::path> Cache::getPath(Span<const Byte> Data,
                                              Cache::StorageScope Scope,
-                                             std::string_view Key) {
+                                             std::string_view Key,
+                                             std::string_view Options) {
   auto Root = getRoot(Scope);
+  if (Root.empty()) {
+    return Unexpect(ErrCode::Value::IllegalPath);
+  }
   if (!Key.empty()) {
     Root /= std::filesystem::u8path(Key);
   }
 
   Blake3 Hasher;
   Hasher.update(Data);
+  if (!Options.empty()) {
+    Hasher.update(Span<const Byte>(
+        reinterpret_cast<const Byte *>(Options.data()), Options.size()));
+  }
   std::array<Byte, 32> Hash;
   Hasher.finalize(Hash);
   std::string HexStr;
@@ -60,5 +77,70 @@ void Cache::clear(Cache::StorageScope Scope, std::string_view Key) {
   std::filesystem::remove_all(Root, ErrCode);
 }
 
+void Cache::touch(const std::filesystem::path &Path) noexcept {
+  std::error_code ErrCode;
+  std::filesystem::last_write_time(
+      Path, std::filesystem::file_time_type::clock::now(), ErrCode);
+}
+
+void Cache::prune(const std::filesystem::path &Path, uint64_t Limit) noexcept {
+  if (Limit == 0) {
+    return;
+  }
+  std::error_code ErrCode;
+  std::vector<std::tuple<std::filesystem::file_time_type, uint64_t,
+                         std::filesystem::path>>
+      Entries;
+  uint64_t Total = 0;
+  for (const auto &Entry :
+       std::filesystem::directory_iterator(Path.parent_path(), ErrCode)) {
+    // The lock files and the temporary files have the extensions.
+    if (!Entry.is_regular_file(ErrCode) ||
+        Entry.path().has_extension()) {
+      continue;
+    }
+    const uint64_t Size = Entry.file_size(ErrCode);
+    if (ErrCode) {
+      continue;
+    }
+    Entries.emplace_back(Entry.last_write_time(ErrCode), Size, Entry.path());
+    Total += Size;
+  }
+  std::sort(Entries.begin(), Entries.end());
+  for (const auto &[Time, Size, EntryPath] : Entries) {
+    if (Total <= Limit) {
+      break;
+    }
+    // The loaded files are not affected by the removing.
+    if (std::filesystem::remove(EntryPath, ErrCode)) {
+      Total -= Size;
+    }
+  }
+}
+
+#if WASMEDGE_OS_LINUX || WASMEDGE_OS_MACOS
+Cache::Lock::Lock(const std::filesystem::path &Path) noexcept {
+  auto LockPath = Path;
+  LockPath += ".lock"sv;
+  FD = open(LockPath.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+  if (FD >= 0 && flock(FD, LOCK_EX) != 0) {
+    close(FD);
+    FD = -1;
+  }
+}
+
+Cache::Lock::~Lock() noexcept {
+  if (FD >= 0) {
+    flock(FD, LOCK_UN);
+    close(FD);
+  }
+}
+#else
+// The cached files are still published atomically by renaming, and the
+// concurrent processes may compile the same module at the same time.
+Cache::Lock::Lock(const std::filesystem::path &) noexcept {}
+Cache::Lock::~Lock() noexcept {}
+#endif
+
 } // namespace AOT
 } // namespace WasmEdge
@@ -24,6 +24,7 @@
 #endif
 
 #include <algorithm>
+#include <array>
 #include <chrono>
 #include <cstdint>
 #include <cstdlib>
@@ -421,13 +422,27 @@ public:
                    Span<const ValVariant> Args,
                    Span<ValVariant> Rets) override {
     auto &FuncType = DefType.getCompositeType().getFuncType();
-    std::vector<WasmEdge_Value> Params(FuncType.getParamTypes().size()),
-        Returns(FuncType.getReturnTypes().size());
+    // Use the local buffers for the common small signatures to avoid the heap
+    // allocations in every host function call.
+    std::array<WasmEdge_Value, kSmallValsN> SmallParams, SmallReturns;
+    std::vector<WasmEdge_Value> LargeParams, LargeReturns;
+    Span<WasmEdge_Value> Params(SmallParams.data(),
+                                FuncType.getParamTypes().size());
+    Span<WasmEdge_Value> Returns(SmallReturns.data(),
+                                 FuncType.getReturnTypes().size());
+    if (unlikely(Params.size() > kSmallValsN)) {
+      LargeParams.resize(Params.size());
+      Params = LargeParams;
+    }
+    if (unlikely(Returns.size() > kSmallValsN)) {
+      LargeReturns.resize(Returns.size());
+      Returns = LargeReturns;
+    }
     for (uint32_t I = 0; I < Args.size(); I++) {
       Params[I] = genWasmEdge_Value(Args[I], FuncType.getParamTypes()[I]);
     }
-    WasmEdge_Value *PPtr = Params.size() ? (&Params[0]) : nullptr;
-    WasmEdge_Value *RPtr = Returns.size() ? (&Returns[0]) : nullptr;
+    WasmEdge_Value *PPtr = Params.size() ? Params.data() : nullptr;
+    WasmEdge_Value *RPtr = Returns.size() ? Returns.data() : nullptr;
     auto *CallFrameCxt = toCallFrameCxt(&CallFrame);
     WasmEdge_Result Stat;
     if (Func) {
@@ -454,6 +469,9 @@ public:
   void *getData() const noexcept { return Data; }
 
 private:
+  /// Maximum params or returns count passed without heap allocation.
+  static inline constexpr const size_t kSmallValsN = 8;
+
   WasmEdge_HostFunc_t Func;
   WasmEdge_WrapFunc_t Wrap;
   void *Binding;
@@ -910,6 +928,153 @@ WasmEdge_ConfigureIsForceInterpreter(const WasmEdge_ConfigureContext *Cxt) {
   return false;
 }
 
+WASMEDGE_CAPI_EXPORT void
+WasmEdge_ConfigureSetLazyValidation(WasmEdge_ConfigureContext *Cxt,
+                                    const bool IsLazyValidation) {
+  if (Cxt) {
+    Cxt->Conf.getRuntimeConfigure().setLazyValidation(IsLazyValidation);
+  }
+}
+
+WASMEDGE_CAPI_EXPORT bool
+WasmEdge_ConfigureIsLazyValidation(const WasmEdge_ConfigureContext *Cxt) {
+  if (Cxt) {
+    return Cxt->Conf.getRuntimeConfigure().isLazyValidation();
+  }
+  return false;
+}
+
+WASMEDGE_CAPI_EXPORT void
+WasmEdge_ConfigureSetGuardPageCheck(WasmEdge_ConfigureContext *Cxt,
+                                    const bool IsGuardPageCheck) {
+  if (Cxt) {
+    Cxt->Conf.getRuntimeConfigure().setGuardPageCheck(IsGuardPageCheck);
+  }
+}
+
+WASMEDGE_CAPI_EXPORT bool
+WasmEdge_ConfigureIsGuardPageCheck(const WasmEdge_ConfigureContext *Cxt) {
+  if (Cxt) {
+    return Cxt->Conf.getRuntimeConfigure().isGuardPageCheck();
+  }
+  return false;
+}
+
+WASMEDGE_CAPI_EXPORT void
+WasmEdge_ConfigureSetMaxThreads(WasmEdge_ConfigureContext *Cxt,
+                                const uint32_t Num) {
+  if (Cxt) {
+    Cxt->Conf.getRuntimeConfigure().setMaxThreads(Num);
+  }
+}
+
+WASMEDGE_CAPI_EXPORT uint32_t
+WasmEdge_ConfigureGetMaxThreads(const WasmEdge_ConfigureContext *Cxt) {
+  if (Cxt) {
+    return Cxt->Conf.getRuntimeConfigure().getMaxThreads();
+  }
+  return 0;
+}
+
+WASMEDGE_CAPI_EXPORT void
+WasmEdge_ConfigureSetHugePageMode(WasmEdge_ConfigureContext *Cxt,
+                                  const enum WasmEdge_MemoryHugePageMode Mode) {
+  if (Cxt) {
+    Cxt->Conf.getRuntimeConfigure().setHugePageMode(
+        static_cast<WasmEdge::RuntimeConfigure::HugePageMode>(Mode));
+  }
+}
+
+WASMEDGE_CAPI_EXPORT enum WasmEdge_MemoryHugePageMode
+WasmEdge_ConfigureGetHugePageMode(const WasmEdge_ConfigureContext *Cxt) {
+  if (Cxt) {
+    return static_cast<WasmEdge_MemoryHugePageMode>(
+        Cxt->Conf.getRuntimeConfigure().getHugePageMode());
+  }
+  return WasmEdge_MemoryHugePageMode_None;
+}
+
+WASMEDGE_CAPI_EXPORT void
+WasmEdge_ConfigureSetNUMALocalMemory(WasmEdge_ConfigureContext *Cxt,
+                                     const bool IsNUMALocalMemory) {
+  if (Cxt) {
+    Cxt->Conf.getRuntimeConfigure().setNUMALocalMemory(IsNUMALocalMemory);
+  }
+}
+
+WASMEDGE_CAPI_EXPORT bool
+WasmEdge_ConfigureIsNUMALocalMemory(const WasmEdge_ConfigureContext *Cxt) {
+  if (Cxt) {
+    return Cxt->Conf.getRuntimeConfigure().isNUMALocalMemory();
+  }
+  return false;
+}
+
+WASMEDGE_CAPI_EXPORT void
+WasmEdge_ConfigureSetMemoryPoolSlots(WasmEdge_ConfigureContext *Cxt,
+                                     const uint32_t Num) {
+  if (Cxt) {
+    Cxt->Conf.getRuntimeConfigure().setMemoryPoolSlots(Num);
+  }
+}
+
+WASMEDGE_CAPI_EXPORT uint32_t
+WasmEdge_ConfigureGetMemoryPoolSlots(const WasmEdge_ConfigureContext *Cxt) {
+  if (Cxt) {
+    return Cxt->Conf.getRuntimeConfigure().getMemoryPoolSlots();
+  }
+  return 0;
+}
+
+WASMEDGE_CAPI_EXPORT void
+WasmEdge_ConfigureSetMemoryKeepResidentPages(WasmEdge_ConfigureContext *Cxt,
+                                             const uint32_t Page) {
+  if (Cxt) {
+    Cxt->Conf.getRuntimeConfigure().setMemoryKeepResidentPages(Page);
+  }
+}
+
+WASMEDGE_CAPI_EXPORT uint32_t WasmEdge_ConfigureGetMemoryKeepResidentPages(
+    const WasmEdge_ConfigureContext *Cxt) {
+  if (Cxt) {
+    return Cxt->Conf.getRuntimeConfigure().getMemoryKeepResidentPages();
+  }
+  return 0;
+}
+
+WASMEDGE_CAPI_EXPORT void WasmEdge_ConfigureSetMemoryGrowthMode(
+    WasmEdge_ConfigureContext *Cxt, const enum WasmEdge_MemoryGrowthMode Mode) {
+  if (Cxt) {
+    Cxt->Conf.getRuntimeConfigure().setMemoryGrowthMode(
+        static_cast<WasmEdge::RuntimeConfigure::MemoryGrowthMode>(Mode));
+  }
+}
+
+WASMEDGE_CAPI_EXPORT enum WasmEdge_MemoryGrowthMode
+WasmEdge_ConfigureGetMemoryGrowthMode(const WasmEdge_ConfigureContext *Cxt) {
+  if (Cxt) {
+    return static_cast<WasmEdge_MemoryGrowthMode>(
+        Cxt->Conf.getRuntimeConfigure().getMemoryGrowthMode());
+  }
+  return WasmEdge_MemoryGrowthMode_Exact;
+}
+
+WASMEDGE_CAPI_EXPORT void
+WasmEdge_ConfigureSetMemoryGrowthStepPages(WasmEdge_ConfigureContext *Cxt,
+                                           const uint32_t Page) {
+  if (Cxt) {
+    Cxt->Conf.getRuntimeConfigure().setMemoryGrowthStepPages(Page);
+  }
+}
+
+WASMEDGE_CAPI_EXPORT uint32_t WasmEdge_ConfigureGetMemoryGrowthStepPages(
+    const WasmEdge_ConfigureContext *Cxt) {
+  if (Cxt) {
+    return Cxt->Conf.getRuntimeConfigure().getMemoryGrowthStepPages();
+  }
+  return 0;
+}
+
 WASMEDGE_CAPI_EXPORT void WasmEdge_ConfigureCompilerSetOptimizationLevel(
     WasmEdge_ConfigureContext *Cxt,
     const enum WasmEdge_CompilerOptimizationLevel Level) {
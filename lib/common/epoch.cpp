@@ -0,0 +1,67 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2019-2022 Second State INC
+
+#include "common/epoch.h"
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace WasmEdge {
+
+namespace {
+/// State of the timer thread. Never destructed, for the detached thread may
+/// still run in the process exit.
+struct TimerState {
+  const Epoch::Clock::time_point Start = Epoch::Clock::now();
+  std::mutex Mutex;
+  std::condition_variable Cond;
+  uint32_t Users = 0;
+  bool Started = false;
+};
+
+TimerState &getState() noexcept {
+  static auto *State = new TimerState();
+  return *State;
+}
+} // namespace
+
+std::atomic_uint64_t Epoch::Counter = 0;
+
+Epoch::Clock::time_point Epoch::getStart() noexcept {
+  return getState().Start;
+}
+
+void Epoch::acquire() {
+  auto &State = getState();
+  std::unique_lock Lock(State.Mutex);
+  if (State.Users++ > 0) {
+    return;
+  }
+  if (State.Started) {
+    State.Cond.notify_one();
+    return;
+  }
+  State.Started = true;
+  std::thread([&State]() {
+    std::unique_lock Lock(State.Mutex);
+    while (true) {
+      State.Cond.wait(Lock, [&State]() { return State.Users > 0; });
+      Lock.unlock();
+      // Store the elapsed ticks instead of counting the wake-ups, so the
+      // late wake-ups do not delay the epoch.
+      const auto Ticks = (Clock::now() - State.Start) / kTick;
+      Counter.store(static_cast<uint64_t>(Ticks), std::memory_order_relaxed);
+      std::this_thread::sleep_until(State.Start + (Ticks + 1) * kTick);
+      Lock.lock();
+    }
+  }).detach();
+}
+
+void Epoch::release() noexcept {
+  auto &State = getState();
+  std::unique_lock Lock(State.Mutex);
+  State.Users--;
+}
+
+} // namespace WasmEdge
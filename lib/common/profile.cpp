@@ -0,0 +1,86 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2019-2022 Second State INC
+
+#include "common/profile.h"
+
+#include "common/spdlog.h"
+
+#include <fstream>
+#include <string>
+
+using namespace std::literals;
+
+namespace WasmEdge {
+
+namespace {
+constexpr std::string_view kMagic = "wasmedge-profile"sv;
+constexpr uint32_t kVersion = 1;
+} // namespace
+
+Expect<void> Profile::save(const std::filesystem::path &Path) const {
+  std::ofstream OS(Path, std::ios_base::trunc);
+  if (!OS) {
+    spdlog::error(ErrCode::Value::IllegalPath);
+    spdlog::error("    Profile file: {}"sv, Path.u8string());
+    return Unexpect(ErrCode::Value::IllegalPath);
+  }
+  OS << kMagic << ' ' << kVersion << '\n';
+  for (const auto &[Index, Count] : Functions) {
+    OS << "function " << Index << ' ' << Count << '\n';
+  }
+  for (const auto &[Offset, Count] : Branches) {
+    OS << "branch " << Offset << ' ' << Count.Taken << ' ' << Count.NotTaken
+       << '\n';
+  }
+  if (!OS.flush()) {
+    spdlog::error(ErrCode::Value::IllegalPath);
+    spdlog::error("    Profile file: {}"sv, Path.u8string());
+    return Unexpect(ErrCode::Value::IllegalPath);
+  }
+  return {};
+}
+
+Expect<Profile> Profile::load(const std::filesystem::path &Path) {
+  std::ifstream IS(Path);
+  if (!IS) {
+    spdlog::error(ErrCode::Value::IllegalPath);
+    spdlog::error("    Profile file: {}"sv, Path.u8string());
+    return Unexpect(ErrCode::Value::IllegalPath);
+  }
+  auto Malformed = [&Path]() {
+    spdlog::error(ErrCode::Value::ReadError);
+    spdlog::error("    Malformed profile file: {}"sv, Path.u8string());
+    return Unexpect(ErrCode::Value::ReadError);
+  };
+
+  std::string Kind;
+  uint32_t Version = 0;
+  if (!(IS >> Kind >> Version) || Kind != kMagic || Version != kVersion) {
+    return Malformed();
+  }
+  Profile Prof;
+  while (IS >> Kind) {
+    uint32_t Key = 0;
+    if (Kind == "function"sv) {
+      uint64_t Count = 0;
+      if (!(IS >> Key >> Count)) {
+        return Malformed();
+      }
+      Prof.addFunctionCount(Key, Count);
+    } else if (Kind == "branch"sv) {
+      BranchCount Count;
+      if (!(IS >> Key >> Count.Taken >> Count.NotTaken)) {
+        return Malformed();
+      }
+      Prof.addBranchCount(Key, Count);
+    } else {
+      return Malformed();
+    }
+  }
+  if (!IS.eof()) {
+    return Malformed();
+  }
+  return Prof;
+}
+
+} // namespace WasmEdge
@@ -4,6 +4,7 @@
 #include "common/configure.h"
 #include "common/defines.h"
 #include "common/filesystem.h"
+#include "common/profile.h"
 #include "common/version.h"
 #include "driver/compiler.h"
 #include "loader/loader.h"
@@ -154,12 +155,28 @@ int Compiler([[maybe_unused]] struct DriverCompilerOptions &Opt) noexcept {
     if (Opt.ConfGenericBinary.value()) {
       Conf.getCompilerConfigure().setGenericBinary(true);
     }
+    if (Opt.ConfFatBinary.value()) {
+      Conf.getCompilerConfigure().setFatBinary(true);
+    }
+    Conf.getCompilerConfigure().setCompileThreadNum(
+        Opt.ConfCompileThreadNum.value());
     if (OutputPath.extension().u8string() == WASMEDGE_LIB_EXTENSION) {
       Conf.getCompilerConfigure().setOutputFormat(
           CompilerConfigure::OutputFormat::Native);
     }
     LLVM::Compiler Compiler(Conf);
     LLVM::CodeGen CodeGen(Conf);
+    if (!Opt.ProfileUse.value().empty()) {
+      if (auto Res = Profile::load(
+              std::filesystem::u8path(Opt.ProfileUse.value().back()));
+          !Res) {
+        const auto Err = static_cast<uint32_t>(Res.error());
+        spdlog::error("Load profile failed. Error code: {}", Err);
+        return EXIT_FAILURE;
+      } else {
+        Compiler.setProfile(std::move(*Res));
+      }
+    }
     if (auto Res = Compiler.compile(*Module); !Res) {
       const auto Err = static_cast<uint32_t>(Res.error());
       spdlog::error("Compilation failed. Error code: {}", Err);
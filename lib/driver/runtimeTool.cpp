@@ -60,6 +60,9 @@ int Tool(struct DriverToolOptions &Opt) noexcept {
   if (Opt.PropMultiMem.value()) {
     Conf.addProposal(Proposal::MultiMemories);
   }
+  if (Opt.PropMemory64.value()) {
+    Conf.addProposal(Proposal::Memory64);
+  }
   if (Opt.PropTailCall.value()) {
     Conf.addProposal(Proposal::TailCall);
   }
@@ -85,6 +88,7 @@ int Tool(struct DriverToolOptions &Opt) noexcept {
   }
   if (Opt.PropAll.value()) {
     Conf.addProposal(Proposal::MultiMemories);
+    Conf.addProposal(Proposal::Memory64);
     Conf.addProposal(Proposal::TailCall);
     Conf.addProposal(Proposal::ExtendedConst);
     Conf.addProposal(Proposal::Threads);
@@ -150,14 +154,35 @@ int Tool(struct DriverToolOptions &Opt) noexcept {
       Conf.getStatisticsConfigure().setSnapShotting(true);
     }
   }
-  if (Opt.ConfEnableJIT.value()) {
+  if (Opt.ConfEnableJIT.value() || Opt.ConfEnableTieredJIT.value() ||
+      Opt.ConfEnableLazyJIT.value()) {
     Conf.getRuntimeConfigure().setEnableJIT(true);
     Conf.getCompilerConfigure().setOptimizationLevel(
         WasmEdge::CompilerConfigure::OptimizationLevel::O1);
   }
+  if (Opt.ConfEnableTieredJIT.value()) {
+    Conf.getRuntimeConfigure().setEnableTieredJIT(true);
+  }
+  if (Opt.ConfEnableLazyJIT.value()) {
+    Conf.getRuntimeConfigure().setEnableLazyJIT(true);
+  }
+  if (Opt.ConfEnableAOTCache.value()) {
+    Conf.getRuntimeConfigure().setEnableAOTCache(true);
+  }
+  if (!Opt.ProfileGenerate.value().empty()) {
+    // The execution counts are collected in the interpreter.
+    Conf.getStatisticsConfigure().setProfiling(true);
+    Conf.getRuntimeConfigure().setEnableJIT(false);
+    Conf.getRuntimeConfigure().setEnableTieredJIT(false);
+    Conf.getRuntimeConfigure().setEnableAOTCache(false);
+    Conf.getRuntimeConfigure().setForceInterpreter(true);
+  }
   if (Opt.ConfForceInterpreter.value()) {
     Conf.getRuntimeConfigure().setForceInterpreter(true);
   }
+  if (Opt.ConfGuardPageCheck.value()) {
+    Conf.getRuntimeConfigure().setGuardPageCheck(true);
+  }
 
   for (const auto &Name : Opt.ForbiddenPlugins.value()) {
     Conf.addForbiddenPlugins(Name);
@@ -259,16 +284,30 @@ int Tool(struct DriverToolOptions &Opt) noexcept {
     }
   };
 
+  auto ExportProfile = [&]() {
+    if (!Opt.ProfileGenerate.value().empty()) {
+      VM.getExecutor()
+          .getProfile(*VM.getActiveModule())
+          .save(std::filesystem::u8path(Opt.ProfileGenerate.value().back()));
+    }
+  };
+
   if (EnterCommandMode) {
     // command mode
+    if (Timeout.has_value()) {
+      VM.getExecutor().setTimeLimit(*Timeout);
+    }
     auto AsyncResult = VM.asyncExecute("_start"sv);
     if (Timeout.has_value()) {
+      // The running code is interrupted by the epoch. Cancel the blocked
+      // waits and host functions which do not check it.
       if (!AsyncResult.waitUntil(*Timeout)) {
         AsyncResult.cancel();
       }
     }
-    if (auto Result = AsyncResult.get();
-        Result || Result.error() == ErrCode::Value::Terminated) {
+    auto Result = AsyncResult.get();
+    ExportProfile();
+    if (Result || Result.error() == ErrCode::Value::Terminated) {
       ExportExit(static_cast<int>(WasiMod->getEnv().getExitCode()));
       return static_cast<int>(WasiMod->getEnv().getExitCode());
     } else {
@@ -375,13 +414,20 @@ int Tool(struct DriverToolOptions &Opt) noexcept {
       }
     }
 
+    if (Timeout.has_value()) {
+      VM.getExecutor().setTimeLimit(*Timeout);
+    }
     auto AsyncResult = VM.asyncExecute(FuncName, FuncArgs, FuncArgTypes);
     if (Timeout.has_value()) {
+      // The running code is interrupted by the epoch. Cancel the blocked
+      // waits and host functions which do not check it.
       if (!AsyncResult.waitUntil(*Timeout)) {
         AsyncResult.cancel();
       }
     }
-    if (auto Result = AsyncResult.get()) {
+    auto Result = AsyncResult.get();
+    ExportProfile();
+    if (Result) {
       ExportResult(Result);
       /// Print results.
       for (size_t I = 0; I < Result->size(); ++I) {
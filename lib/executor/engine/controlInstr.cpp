@@ -13,6 +13,11 @@ Expect<void> Executor::runIfElseOp(Runtime::StackManager &StackMgr,
                                    AST::InstrView::iterator &PC) noexcept {
   // Get condition.
   uint32_t Cond = StackMgr.pop().get<uint32_t>();
+  if (unlikely(Profiling != nullptr)) {
+    std::unique_lock Lock(Profiling->Mutex);
+    auto &Count = Profiling->Branches[&Instr];
+    ++(Cond != 0 ? Count.Taken : Count.NotTaken);
+  }
 
   // If non-zero, run if-statement; else, run else-statement.
   if (Cond == 0) {
@@ -64,7 +69,13 @@ Expect<void> Executor::runBrOp(Runtime::StackManager &StackMgr,
 Expect<void> Executor::runBrIfOp(Runtime::StackManager &StackMgr,
                                  const AST::Instruction &Instr,
                                  AST::InstrView::iterator &PC) noexcept {
-  if (StackMgr.pop().get<uint32_t>() != 0) {
+  const uint32_t Cond = StackMgr.pop().get<uint32_t>();
+  if (unlikely(Profiling != nullptr)) {
+    std::unique_lock Lock(Profiling->Mutex);
+    auto &Count = Profiling->Branches[&Instr];
+    ++(Cond != 0 ? Count.Taken : Count.NotTaken);
+  }
+  if (Cond != 0) {
     return runBrOp(StackMgr, Instr, PC);
   }
   return {};
@@ -134,7 +145,7 @@ Expect<void> Executor::runBrOnCastOp(Runtime::StackManager &StackMgr,
 Expect<void> Executor::runReturnOp(Runtime::StackManager &StackMgr,
                                    AST::InstrView::iterator &PC) noexcept {
   // Check stop token
-  if (unlikely(StopToken.exchange(0, std::memory_order_relaxed))) {
+  if (unlikely(checkInterrupted())) {
     spdlog::error(ErrCode::Value::Interrupted);
     return Unexpect(ErrCode::Value::Interrupted);
   }
@@ -251,7 +262,13 @@ Expect<void> Executor::runTryTableOp(Runtime::StackManager &StackMgr,
                                      const AST::Instruction &Instr,
                                      AST::InstrView::iterator &PC) noexcept {
   const auto &TryDesc = Instr.getTryCatch();
-  StackMgr.pushHandler(PC, TryDesc.BlockParamNum, TryDesc.Catch);
+  if (unlikely(!StackMgr.pushHandler(PC, TryDesc.BlockParamNum,
+                                     TryDesc.Catch))) {
+    spdlog::error(ErrCode::Value::CallStackExhausted);
+    spdlog::error(
+        ErrInfo::InfoInstruction(Instr.getOpCode(), Instr.getOffset()));
+    return Unexpect(ErrCode::Value::CallStackExhausted);
+  }
   return {};
 }
 
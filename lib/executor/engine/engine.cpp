@@ -3,6 +3,7 @@
 
 #include "executor/executor.h"
 #include "runtime/serializemgr.h"
+#include "system/fault.h"
 
 #include <array>
 #include <cstdint>
@@ -18,8 +19,12 @@ namespace Executor {
 Expect<void> Executor::runExpression(Runtime::StackManager &StackMgr,
                                      AST::InstrView Instrs) {
   auto Res = execute(StackMgr, Instrs.begin(), Instrs.end());
-  Stat->clearCost();
-  spdlog::error("Initializaion function Called. Refill cost pool. Current cost count: {}", Stat->getTotalCost());
+  if (Stat) {
+    Stat->clearCost();
+    spdlog::debug("Initializaion function Called. Refill cost pool. Current "
+                  "cost count: {}",
+                  Stat->getTotalCost());
+  }
   return Res;
 }
 
@@ -27,11 +32,22 @@ Expect<void>
 Executor::runFunction(Runtime::StackManager &StackMgr,
                       const Runtime::Instance::FunctionInstance &Func,
                       Span<const ValVariant> Params) {
+  // Load the lazy function body before referring to its end iterator.
+  if (auto Res = prepareFunction(Func); unlikely(!Res)) {
+    return Unexpect(Res);
+  }
+
   // Set start time.
   if (Stat && Conf.getStatisticsConfigure().isTimeMeasuring()) {
     Stat->startRecordWasm();
   }
 
+  // Check the stack capacity for the dummy frame and the arguments.
+  if (unlikely(!StackMgr.hasCapacity(static_cast<uint32_t>(Params.size())))) {
+    spdlog::error(ErrCode::Value::CallStackExhausted);
+    return Unexpect(ErrCode::Value::CallStackExhausted);
+  }
+
   // Reset and push a dummy frame into stack.
   StackMgr.pushFrame(nullptr, AST::InstrView::iterator(), 0, 0);
 
@@ -82,7 +98,11 @@ Executor::runFunction(Runtime::StackManager &StackMgr,
 
     // std::cerr << " **** Start: " << StartIt - Func.getInstrs().end() << "\n";
 
-    Res = execute(StackMgr, StartIt, Func.getInstrs().end());
+    if (GuardPageCheck) {
+      Res = executeGuarded(StackMgr, StartIt, Func.getInstrs().end());
+    } else {
+      Res = execute(StackMgr, StartIt, Func.getInstrs().end());
+    }
   }
 
   if (Res) {
@@ -109,6 +129,20 @@ Executor::runFunction(Runtime::StackManager &StackMgr,
   return Unexpect(Res);
 }
 
+Expect<void> Executor::executeGuarded(Runtime::StackManager &StackMgr,
+                                      const AST::InstrView::iterator Start,
+                                      const AST::InstrView::iterator End) {
+  // The out-of-bound loads and stores on the guarded memories fault in the
+  // guard region and jump back here.
+  Fault FaultHandler;
+  if (uint32_t Code = PREPARE_FAULT(FaultHandler); Code != 0) {
+    ErrCode Err(static_cast<ErrCategory>(Code >> 24), Code);
+    spdlog::error(Err);
+    return Unexpect(Err);
+  }
+  return execute(StackMgr, Start, End);
+}
+
 Expect<void> Executor::execute(Runtime::StackManager &StackMgr,
                                const AST::InstrView::iterator Start,
                                const AST::InstrView::iterator End) {
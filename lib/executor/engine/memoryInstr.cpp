@@ -10,7 +10,11 @@ Expect<void>
 Executor::runMemorySizeOp(Runtime::StackManager &StackMgr,
                           Runtime::Instance::MemoryInstance &MemInst) {
   // Push SZ = page size to stack.
-  StackMgr.push(MemInst.getPageSize());
+  if (MemInst.is64()) {
+    StackMgr.push(static_cast<uint64_t>(MemInst.getPageSize()));
+  } else {
+    StackMgr.push(MemInst.getPageSize());
+  }
   return {};
 }
 
@@ -18,6 +22,18 @@ Expect<void>
 Executor::runMemoryGrowOp(Runtime::StackManager &StackMgr,
                           Runtime::Instance::MemoryInstance &MemInst) {
   // Pop N for growing page size.
+  if (MemInst.is64()) {
+    // The page counts of the 64-bit memory are still limited in 32-bit.
+    uint64_t &N = StackMgr.getTop().get<uint64_t>();
+    const uint64_t CurrPageSize = MemInst.getPageSize();
+    if (N <= std::numeric_limits<uint32_t>::max() &&
+        MemInst.growPage(static_cast<uint32_t>(N))) {
+      N = CurrPageSize;
+    } else {
+      N = static_cast<uint64_t>(-1);
+    }
+    return {};
+  }
   uint32_t &N = StackMgr.getTop().get<uint32_t>();
 
   // Grow page and push result.
@@ -36,7 +52,7 @@ Expect<void> Executor::runMemoryInitOp(
   // Pop the length, source, and destination from stack.
   uint32_t Len = StackMgr.pop().get<uint32_t>();
   uint32_t Src = StackMgr.pop().get<uint32_t>();
-  uint32_t Dst = StackMgr.pop().get<uint32_t>();
+  uint64_t Dst = getMemoryAddress(StackMgr.pop(), MemInst);
 
   // Replace mem[Dst : Dst + Len] with data[Src : Src + Len].
   if (auto Res = MemInst.setBytes(DataInst.getData(), Dst, Src, Len)) {
@@ -61,9 +77,12 @@ Executor::runMemoryCopyOp(Runtime::StackManager &StackMgr,
                           Runtime::Instance::MemoryInstance &MemInstSrc,
                           const AST::Instruction &Instr) {
   // Pop the length, source, and destination from stack.
-  uint32_t Len = StackMgr.pop().get<uint32_t>();
-  uint32_t Src = StackMgr.pop().get<uint32_t>();
-  uint32_t Dst = StackMgr.pop().get<uint32_t>();
+  // The length is i64 only if both memories are 64-bit.
+  uint64_t Len = MemInstDst.is64() && MemInstSrc.is64()
+                     ? StackMgr.pop().get<uint64_t>()
+                     : StackMgr.pop().get<uint32_t>();
+  uint64_t Src = getMemoryAddress(StackMgr.pop(), MemInstSrc);
+  uint64_t Dst = getMemoryAddress(StackMgr.pop(), MemInstDst);
 
   // Replace mem[Dst : Dst + Len] with mem[Src : Src + Len].
   if (auto Data = MemInstSrc.getBytes(Src, Len)) {
@@ -86,9 +105,9 @@ Executor::runMemoryFillOp(Runtime::StackManager &StackMgr,
                           Runtime::Instance::MemoryInstance &MemInst,
                           const AST::Instruction &Instr) {
   // Pop the length, value, and offset from stack.
-  uint32_t Len = StackMgr.pop().get<uint32_t>();
+  uint64_t Len = getMemoryAddress(StackMgr.pop(), MemInst);
   uint8_t Val = static_cast<uint8_t>(StackMgr.pop().get<uint32_t>());
-  uint32_t Off = StackMgr.pop().get<uint32_t>();
+  uint64_t Off = getMemoryAddress(StackMgr.pop(), MemInst);
 
   // Fill data with Val.
   if (auto Res = MemInst.fillBytes(Val, Off, Len)) {
@@ -101,6 +101,9 @@ Expect<void> Executor::call(Runtime::StackManager &StackMgr,
     StackMgr.push(Args[I]);
   }
 
+  if (auto Res = prepareFunction(*FuncInst); unlikely(!Res)) {
+    return Unexpect(Res);
+  }
   auto Instrs = FuncInst->getInstrs();
   AST::InstrView::iterator StartIt;
   if (auto Res = enterFunction(StackMgr, *FuncInst, Instrs.end())) {
@@ -212,6 +215,9 @@ Executor::callIndirect(Runtime::StackManager &StackMgr, const uint32_t TableIdx,
     StackMgr.push(Args[I]);
   }
 
+  if (auto Res = prepareFunction(*FuncInst); unlikely(!Res)) {
+    return Unexpect(Res);
+  }
   auto Instrs = FuncInst->getInstrs();
   AST::InstrView::iterator StartIt;
   if (auto Res = enterFunction(StackMgr, *FuncInst, Instrs.end())) {
@@ -466,6 +472,9 @@ Expect<void> Executor::callRef(Runtime::StackManager &StackMgr,
     StackMgr.push(Args[I]);
   }
 
+  if (auto Res = prepareFunction(*FuncInst); unlikely(!Res)) {
+    return Unexpect(Res);
+  }
   auto Instrs = FuncInst->getInstrs();
   AST::InstrView::iterator StartIt;
   if (auto Res = enterFunction(StackMgr, *FuncInst, Instrs.end())) {
@@ -13,19 +13,7 @@ Executor::runAtomicNotifyOp(Runtime::StackManager &StackMgr,
   ValVariant RawCount = StackMgr.pop();
   ValVariant &RawAddress = StackMgr.getTop();
 
-  uint32_t Address = RawAddress.get<uint32_t>();
-
-  if (Address >
-      std::numeric_limits<uint32_t>::max() - Instr.getMemoryOffset()) {
-    spdlog::error(ErrCode::Value::MemoryOutOfBounds);
-    spdlog::error(ErrInfo::InfoBoundary(
-        Address + static_cast<uint64_t>(Instr.getMemoryOffset()),
-        sizeof(uint32_t), MemInst.getBoundIdx()));
-    spdlog::error(
-        ErrInfo::InfoInstruction(Instr.getOpCode(), Instr.getOffset()));
-    return Unexpect(ErrCode::Value::MemoryOutOfBounds);
-  }
-  Address += Instr.getMemoryOffset();
+  const uint64_t Address = getEffectiveAddress(RawAddress, MemInst, Instr);
 
   if (Address % sizeof(uint32_t) != 0) {
     spdlog::error(ErrCode::Value::UnalignedAtomicAccess);
@@ -53,7 +41,7 @@ Expect<void> Executor::runMemoryFenceOp() {
 
 Expect<uint32_t>
 Executor::atomicNotify(Runtime::Instance::MemoryInstance &MemInst,
-                       uint32_t Address, uint32_t Count) noexcept {
+                       uint64_t Address, uint32_t Count) noexcept {
   // The error message should be handled by the caller, or the AOT mode will
   // produce the duplicated messages.
   if (auto *AtomicObj = MemInst.getPointer<std::atomic<uint32_t> *>(Address);
@@ -61,24 +49,34 @@ Executor::atomicNotify(Runtime::Instance::MemoryInstance &MemInst,
     return Unexpect(ErrCode::Value::MemoryOutOfBounds);
   }
 
-  std::unique_lock<decltype(WaiterMapMutex)> Locker(WaiterMapMutex);
+  // Only the bucket of the (memory, address) key is locked. Other keys in the
+  // same bucket are skipped.
+  auto &Bucket = getWaiterBucket(MemInst, Address);
+  std::unique_lock<decltype(Bucket.Mutex)> Locker(Bucket.Mutex);
   uint32_t Total = 0;
-  auto Range = WaiterMap.equal_range(Address);
-  for (auto Iterator = Range.first; Total < Count && Iterator != Range.second;
-       ++Iterator) {
-    if (likely(&MemInst == Iterator->second.MemInst)) {
-      Iterator->second.Cond.notify_all();
+  Waiter *Iterator = Bucket.Head;
+  while (Total < Count && Iterator != nullptr) {
+    Waiter *Next = Iterator->Next;
+    if (likely(&MemInst == Iterator->MemInst &&
+               Address == Iterator->Address)) {
+      // Dequeue the waiter here to wake up the waiters in FIFO order.
+      Bucket.remove(*Iterator);
+      Iterator->Notified = true;
+      Iterator->Cond.notify_one();
       ++Total;
     }
+    Iterator = Next;
   }
   return Total;
 }
 
 void Executor::atomicNotifyAll() noexcept {
-  std::unique_lock<decltype(WaiterMapMutex)> Locker(WaiterMapMutex);
-  for (auto Iterator = WaiterMap.begin(); Iterator != WaiterMap.end();
-       ++Iterator) {
-    Iterator->second.Cond.notify_all();
+  for (auto &Bucket : WaiterBuckets) {
+    std::unique_lock<decltype(Bucket.Mutex)> Locker(Bucket.Mutex);
+    for (Waiter *Iterator = Bucket.Head; Iterator != nullptr;
+         Iterator = Iterator->Next) {
+      Iterator->Cond.notify_one();
+    }
   }
 }
 
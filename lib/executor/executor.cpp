@@ -6,9 +6,22 @@
 #include "common/errinfo.h"
 #include "common/spdlog.h"
 
+#include <experimental/scope.hpp>
+#include <memory>
+#include <vector>
+
 namespace WasmEdge {
 namespace Executor {
 
+namespace {
+/// Cached stack managers of the current thread. The worker threads of the
+/// asynchronous executions reuse them across the invocations instead of
+/// allocating the new stacks, and the nested invocations from the host
+/// functions take the other ones.
+constexpr const size_t kStackMgrCacheSize = 4;
+thread_local std::vector<std::unique_ptr<Runtime::StackManager>> StackMgrCache;
+} // namespace
+
 Expect<std::unique_ptr<Runtime::Instance::ComponentInstance>>
 Executor::instantiateComponent(Runtime::StoreManager &StoreMgr,
                                const AST::Component::Component &Comp) {
@@ -72,6 +85,8 @@ Executor::registerModule(Runtime::StoreManager &StoreMgr,
     spdlog::error(ErrInfo::InfoAST(ASTNodeAttr::Module));
     return Unexpect(ErrCode::Value::ModuleNameConflict);
   }
+  // Canonicalize the host function types for the fast import matching.
+  canonicalizeTypes(ModInst);
   return {};
 }
 Expect<void> Executor::registerComponent(
@@ -144,7 +159,20 @@ Executor::invoke(const Runtime::Instance::FunctionInstance *FuncInst,
     }
   }
 
-  Runtime::StackManager StackMgr;
+  std::unique_ptr<Runtime::StackManager> StackMgrPtr;
+  if (!StackMgrCache.empty()) {
+    StackMgrPtr = std::move(StackMgrCache.back());
+    StackMgrCache.pop_back();
+  } else {
+    StackMgrPtr = std::make_unique<Runtime::StackManager>();
+  }
+  cxx20::scope_exit RecycleStackMgr([&]() noexcept {
+    if (StackMgrCache.size() < kStackMgrCacheSize) {
+      StackMgrPtr->reset();
+      StackMgrCache.push_back(std::move(StackMgrPtr));
+    }
+  });
+  Runtime::StackManager &StackMgr = *StackMgrPtr;
 
   // Call runFunction.
   if (auto Res = runFunction(StackMgr, *FuncInst, Params); !Res) {
@@ -202,9 +230,37 @@ Executor::asyncInvoke(const Runtime::Instance::FunctionInstance *FuncInst,
   Expect<std::vector<std::pair<ValVariant, ValType>>> (Executor::*FPtr)(
       const Runtime::Instance::FunctionInstance *, Span<const ValVariant>,
       Span<const ValType>) = &Executor::invoke;
-  return {FPtr, *this, FuncInst, std::vector(Params.begin(), Params.end()),
+  return {AsyncPool, FPtr, *this, FuncInst,
+          std::vector(Params.begin(), Params.end()),
           std::vector(ParamTypes.begin(), ParamTypes.end())};
 }
 
+Profile
+Executor::getProfile(const Runtime::Instance::ModuleInstance &ModInst) const {
+  Profile Prof;
+  if (!Profiling) {
+    return Prof;
+  }
+  std::unique_lock Lock(Profiling->Mutex);
+  for (uint32_t I = 0; I < ModInst.getFuncNum(); ++I) {
+    const auto *Func = ModInst.unsafeGetFunction(I);
+    // Skip the imported functions of the other modules.
+    if (Func->getModule() != &ModInst || !Func->isWasmFunction()) {
+      continue;
+    }
+    if (auto It = Profiling->Functions.find(Func);
+        It != Profiling->Functions.end()) {
+      Prof.addFunctionCount(I, It->second);
+    }
+    for (const auto &Instr : Func->getInstrs()) {
+      if (auto It = Profiling->Branches.find(&Instr);
+          It != Profiling->Branches.end()) {
+        Prof.addBranchCount(Instr.getOffset(), It->second);
+      }
+    }
+  }
+  return Prof;
+}
+
 } // namespace Executor
 } // namespace WasmEdge
@@ -6,6 +6,7 @@
 #include "common/spdlog.h"
 #include "system/fault.h"
 
+#include <array>
 #include <cstdint>
 #include <utility>
 #include <vector>
@@ -13,6 +14,22 @@
 namespace WasmEdge {
 namespace Executor {
 
+namespace {
+/// Maximum returns count of the compiled functions passed without heap
+/// allocation.
+inline constexpr const uint32_t kSmallRetsN = 8;
+} // namespace
+
+Expect<void> Executor::prepareFunction(
+    const Runtime::Instance::FunctionInstance &Func) noexcept {
+  if (likely(!Func.isLazyFunction())) {
+    return {};
+  }
+  // Lazy validation mode: decode and validate the function body at the first
+  // call. The defined types of the module instance are used for validation.
+  return Func.loadLazyBody(Func.getModule()->Types);
+}
+
 Expect<AST::InstrView::iterator>
 Executor::enterFunction(Runtime::StackManager &StackMgr,
                         const Runtime::Instance::FunctionInstance &Func,
@@ -20,7 +37,7 @@ Executor::enterFunction(Runtime::StackManager &StackMgr,
   // RetIt: the return position when the entered function returns.
 
   // Check if the interruption occurs.
-  if (unlikely(StopToken.exchange(0, std::memory_order_relaxed))) {
+  if (unlikely(checkInterrupted())) {
     spdlog::error(ErrCode::Value::Interrupted);
     return Unexpect(ErrCode::Value::Interrupted);
   }
@@ -35,6 +52,19 @@ Executor::enterFunction(Runtime::StackManager &StackMgr,
   // branches.
   StackMgr.removeInactiveHandler(RetIt - 1);
 
+  // In the tiered execution, the native function runs the compiled code after
+  // being compiled in the background.
+  void *const TierUpCode =
+      unlikely(TierUpThreshold != 0) ? Func.getTierUpCode() : nullptr;
+
+  // Check the stack capacity for the new frame and the local variables.
+  const uint32_t LocalsN =
+      Func.isWasmFunction() && !TierUpCode ? Func.getLocalNum() : 0U;
+  if (unlikely(!StackMgr.hasCapacity(LocalsN, IsTailCall))) {
+    spdlog::error(ErrCode::Value::CallStackExhausted);
+    return Unexpect(ErrCode::Value::CallStackExhausted);
+  }
+
   if (Func.isHostFunction()) {
     // Host function case: Push args and call function.
     auto &HostFunc = Func.getHostFunc();
@@ -71,15 +101,16 @@ Executor::enterFunction(Runtime::StackManager &StackMgr,
     // Call pre-host-function
     HostFuncHelper.invokePreHostFunc();
 
-    // Run host function.
-    Span<ValVariant> Args = StackMgr.getTopSpan(ArgsN);
+    // Run host function. The returns are written into the slots pushed above
+    // the arguments in the value stack, so no buffer is allocated here.
+    Span<ValVariant> Rets = StackMgr.pushSpan(RetsN);
+    Span<ValVariant> Args = StackMgr.getTopSpan(ArgsN + RetsN).first(ArgsN);
     for (uint32_t I = 0; I < ArgsN; I++) {
       // For the number type cases of the arguments, the unused bits should be
       // erased due to the security issue.
       cleanNumericVal(Args[I], FuncType.getParamTypes()[I]);
     }
-    std::vector<ValVariant> Rets(RetsN);
-    auto Ret = HostFunc.run(CallFrame, std::move(Args), Rets);
+    auto Ret = HostFunc.runDirect(CallFrame, std::move(Args), Rets);
 
     // Call post-host-function
     HostFuncHelper.invokePostHostFunc();
@@ -100,15 +131,10 @@ Executor::enterFunction(Runtime::StackManager &StackMgr,
       return Unexpect(Ret);
     }
 
-    // Push returns back to stack.
-    for (auto &R : Rets) {
-      StackMgr.push(std::move(R));
-    }
-
     // For host function case, the continuation will be the continuation from
-    // the popped frame.
+    // the popped frame. The returns are already on the top of the stack.
     return StackMgr.popFrame();
-  } else if (Func.isCompiledFunction()) {
+  } else if (Func.isCompiledFunction() || TierUpCode) {
     // Compiled function case: Execute the function and jump to the
     // continuation.
 
@@ -120,9 +146,17 @@ Executor::enterFunction(Runtime::StackManager &StackMgr,
                        IsTailCall        // For tail-call
     );
 
-    // Prepare arguments.
+    // Prepare arguments. The compiled function may call back into the
+    // executor and push values onto the same stack, so the returns use a local
+    // buffer instead of the stack slots. Allocate only for the large returns.
     Span<ValVariant> Args = StackMgr.getTopSpan(ArgsN);
-    std::vector<ValVariant> Rets(RetsN);
+    std::array<ValVariant, kSmallRetsN> SmallRets;
+    std::vector<ValVariant> LargeRets;
+    Span<ValVariant> Rets(SmallRets.data(), RetsN);
+    if (unlikely(RetsN > kSmallRetsN)) {
+      LargeRets.assign(RetsN, ValVariant());
+      Rets = LargeRets;
+    }
 
     {
       // Prepare the execution context.
@@ -148,8 +182,10 @@ Executor::enterFunction(Runtime::StackManager &StackMgr,
       if (Code != 0) {
         Err = ErrCode(static_cast<ErrCategory>(Code >> 24), Code);
       } else {
-        auto &Wrapper = FuncType.getSymbol();
-        Wrapper(&ExecutionContext, Func.getSymbol().get(), Args.data(),
+        auto &Wrapper =
+            TierUpCode ? Func.getTierUpWrapper() : FuncType.getSymbol();
+        Wrapper(&ExecutionContext,
+                TierUpCode ? TierUpCode : Func.getSymbol().get(), Args.data(),
                 Rets.data());
       }
     } catch (const ErrCode &E) {
@@ -173,6 +209,20 @@ Executor::enterFunction(Runtime::StackManager &StackMgr,
   } else {
     // Native function case: Jump to the start of the function body.
 
+    // Load the lazy function body.
+    if (auto Res = prepareFunction(Func); unlikely(!Res)) {
+      return Unexpect(Res);
+    }
+
+    // Count the call in the tiered execution.
+    if (unlikely(TierUpThreshold != 0) && Func.addHotness(TierUpThreshold)) {
+      TierUpFunc(Func);
+    }
+    if (unlikely(Profiling != nullptr)) {
+      std::unique_lock Lock(Profiling->Mutex);
+      ++Profiling->Functions[&Func];
+    }
+
     // Push local variables into the stack.
     for (auto &Def : Func.getLocals()) {
       for (uint32_t I = 0; I < Def.first; I++) {
@@ -187,7 +237,8 @@ Executor::enterFunction(Runtime::StackManager &StackMgr,
                        RetIt - 1,                  // Return PC
                        ArgsN + Func.getLocalNum(), // Arguments num + local num
                        RetsN,                      // Returns num
-                       IsTailCall                  // For tail-call
+                       IsTailCall,                 // For tail-call
+                       &Func                       // Function instance
     );
 
     // For native function case, the continuation will be the start of the
@@ -201,11 +252,19 @@ Executor::branchToLabel(Runtime::StackManager &StackMgr,
                         const AST::Instruction::JumpDescriptor &JumpDesc,
                         AST::InstrView::iterator &PC) noexcept {
   // Check the stop token.
-  if (unlikely(StopToken.exchange(0, std::memory_order_relaxed))) {
+  if (unlikely(checkInterrupted())) {
     spdlog::error(ErrCode::Value::Interrupted);
     return Unexpect(ErrCode::Value::Interrupted);
   }
 
+  // Count the loop back edge in the tiered execution.
+  if (unlikely(TierUpThreshold != 0) && JumpDesc.PCOffset < 0) {
+    const auto *Func = StackMgr.getFunction();
+    if (Func && Func->addHotness(TierUpThreshold)) {
+      TierUpFunc(*Func);
+    }
+  }
+
   StackMgr.eraseValueStack(JumpDesc.StackEraseBegin, JumpDesc.StackEraseEnd);
   // PC need to -1 here because the PC will increase in the next iteration.
   PC += (JumpDesc.PCOffset - 1);
@@ -40,7 +40,8 @@ Expect<void> Executor::instantiate(Runtime::Instance::ModuleInstance &ModInst,
       ModInst.addFunc(
           TypeIdxs[I],
           (*ModInst.getType(TypeIdxs[I]))->getCompositeType().getFuncType(),
-          CodeSegs[I].getLocals(), CodeSegs[I].getExpr().getInstrs());
+          CodeSegs[I].getLocals(), CodeSegs[I].getExpr().getInstrs(),
+          CodeSegs[I].getLazyDecoder(), CodeSegs[I].getLazyChecker());
     }
   }
   return {};
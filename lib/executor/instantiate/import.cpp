@@ -33,7 +33,7 @@ auto logUnknownError(std::string_view ModName, std::string_view ExtName,
 }
 
 bool matchLimit(const AST::Limit &Exp, const AST::Limit &Got) {
-  if (Exp.isShared() != Got.isShared()) {
+  if (Exp.isShared() != Got.isShared() || Exp.is64() != Got.is64()) {
     return false;
   }
   if ((Got.getMin() < Exp.getMin()) || (Exp.hasMax() && !Got.hasMax())) {
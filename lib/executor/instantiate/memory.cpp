@@ -15,10 +15,38 @@ Expect<void> Executor::instantiate(Runtime::Instance::ModuleInstance &ModInst,
   ModInst.MemoryPtrs.resize(ModInst.getMemoryNum() +
                             MemSec.getContent().size());
 
+  // Allocation policy of the memory pages.
+  const auto &RTConf = Conf.getRuntimeConfigure();
+  Allocator::Policy Policy;
+  switch (RTConf.getHugePageMode()) {
+  case RuntimeConfigure::HugePageMode::Transparent:
+    Policy.HugePageMode = Allocator::HugePage::Transparent;
+    break;
+  case RuntimeConfigure::HugePageMode::HugeTLB:
+    Policy.HugePageMode = Allocator::HugePage::HugeTLB;
+    break;
+  default:
+    break;
+  }
+  Policy.NUMALocal = RTConf.isNUMALocalMemory();
+  Policy.PoolSlots = RTConf.getMemoryPoolSlots();
+  Policy.KeepResidentPages = RTConf.getMemoryKeepResidentPages();
+  switch (RTConf.getMemoryGrowthMode()) {
+  case RuntimeConfigure::MemoryGrowthMode::Fixed:
+    Policy.GrowthMode = Allocator::Growth::Fixed;
+    break;
+  case RuntimeConfigure::MemoryGrowthMode::Geometric:
+    Policy.GrowthMode = Allocator::Growth::Geometric;
+    break;
+  default:
+    break;
+  }
+  Policy.GrowthStepPages = RTConf.getMemoryGrowthStepPages();
+
   // Iterate through the memory types to instantiate memory instances.
   for (const auto &MemType : MemSec.getContent()) {
     // Create and add the memory instance into the module instance.
-    ModInst.addMemory(MemType, Conf.getRuntimeConfigure().getMaxMemoryPage());
+    ModInst.addMemory(MemType, RTConf.getMaxMemoryPage(), Policy);
   }
   return {};
 }
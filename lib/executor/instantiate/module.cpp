@@ -23,8 +23,13 @@ Executor::instantiate(Runtime::StoreManager &StoreMgr, const AST::Module &Mod,
     return Unexpect(ErrCode::Value::NotValidated);
   }
 
-  // Create the stack manager.
+  // Create the stack manager. The stacks are empty if failed to allocate.
   Runtime::StackManager StackMgr;
+  if (unlikely(!StackMgr.hasCapacity(0))) {
+    spdlog::error(ErrCode::Value::CallStackExhausted);
+    spdlog::error(ErrInfo::InfoAST(ASTNodeAttr::Module));
+    return Unexpect(ErrCode::Value::CallStackExhausted);
+  }
 
   // Check is module name duplicated when trying to registration.
   if (Name.has_value()) {
@@ -45,10 +50,9 @@ Executor::instantiate(Runtime::StoreManager &StoreMgr, const AST::Module &Mod,
   }
 
   // Instantiate Function Types in Module Instance. (TypeSec)
-  for (auto &SubType : Mod.getTypeSection().getContent()) {
-    // Copy defined types to module instance.
-    ModInst->addDefinedType(SubType);
-  }
+  const AST::TypeSection &TypeSec = Mod.getTypeSection();
+  // This function will always success.
+  instantiate(*ModInst, TypeSec);
 
   // Instantiate ImportSection and do import matching. (ImportSec)
   const AST::ImportSection &ImportSec = Mod.getImportSection();
@@ -70,6 +74,16 @@ Executor::instantiate(Runtime::StoreManager &StoreMgr, const AST::Module &Mod,
   // This function will always success.
   instantiate(*ModInst, MemSec);
 
+  // The compiled code, including the functions compiled later in the tiered
+  // execution, and the guard page checked interpreter rely on the guard pages
+  // for the bound checking. Commit the pages of the defined and imported
+  // memories exactly for them.
+  if (Mod.getSymbol() || GuardPageCheck || TierUpThreshold != 0) {
+    for (uint32_t I = 0; I < ModInst->getMemoryNum(); ++I) {
+      ModInst->unsafeGetMemory(I)->setExactCommit();
+    }
+  }
+
   // Instantiate TagSection (TagSec)
   const AST::TagSection &TagSec = Mod.getTagSection();
   // This function will always success.
@@ -0,0 +1,181 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2019-2022 Second State INC
+
+#include "executor/executor.h"
+
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace WasmEdge {
+namespace Executor {
+
+namespace {
+
+/// Process-wide canonical type table. Every distinct recursive type group is
+/// interned once and its subtypes are assigned with the dense IDs
+/// `[Base, Base + GroupSize)`. The IDs are shared by all the stores because the
+/// host module instances and the instantiated module instances can be
+/// registered into multiple stores.
+class TypeRegistry {
+public:
+  static TypeRegistry &getInstance() noexcept {
+    static TypeRegistry Registry;
+    return Registry;
+  }
+
+  /// Intern the encoded recursive type group and return the base ID.
+  uint32_t intern(std::vector<uint64_t> &&Key, uint32_t GroupSize) {
+    {
+      std::shared_lock Lock(Mutex);
+      if (auto Iter = Groups.find(Key); Iter != Groups.end()) {
+        return Iter->second;
+      }
+    }
+    std::unique_lock Lock(Mutex);
+    auto [Iter, Inserted] = Groups.try_emplace(std::move(Key), NextID);
+    if (Inserted) {
+      NextID += GroupSize;
+    }
+    return Iter->second;
+  }
+
+private:
+  struct KeyHash {
+    size_t operator()(const std::vector<uint64_t> &Key) const noexcept {
+      return std::hash<std::string_view>{}(
+          std::string_view(reinterpret_cast<const char *>(Key.data()),
+                           Key.size() * sizeof(uint64_t)));
+    }
+  };
+
+  mutable std::shared_mutex Mutex;
+  std::unordered_map<std::vector<uint64_t>, uint32_t, KeyHash> Groups;
+  uint32_t NextID = 0;
+};
+
+/// Encoding tags of the value types in the canonical key.
+enum class ValTypeTag : uint64_t { Plain = 0, Internal = 1, External = 2 };
+
+/// Encode the recursive type group `[StartIdx, StartIdx + Size)`. Returns
+/// nullopt if any referenced defined type outside the group is not
+/// canonicalized yet.
+std::optional<std::vector<uint64_t>>
+encodeRecGroup(Span<const AST::SubType *const> Types, uint32_t StartIdx,
+               uint32_t Size) noexcept {
+  std::vector<uint64_t> Key;
+  bool IsValid = true;
+  auto encodeValType = [&](const ValType &VT) {
+    const uint64_t Code = static_cast<uint64_t>(VT.getCode()) << 8;
+    if (VT.getHeapTypeCode() != TypeCode::TypeIndex) {
+      // Abstract heap types and non-reference types.
+      Key.push_back(static_cast<uint64_t>(ValTypeTag::Plain) | Code |
+                    (static_cast<uint64_t>(VT.getHeapTypeCode()) << 16));
+      return;
+    }
+    const uint32_t Idx = VT.getTypeIndex();
+    if (Idx >= StartIdx && Idx < StartIdx + Size) {
+      // Recursive type internal index. Encode the relative index.
+      Key.push_back(static_cast<uint64_t>(ValTypeTag::Internal) | Code |
+                    (static_cast<uint64_t>(Idx - StartIdx) << 32));
+    } else if (Idx < Types.size() && Types[Idx]->getCanonicalID()) {
+      // Referenced defined type outside the group. Encode the canonical ID.
+      Key.push_back(static_cast<uint64_t>(ValTypeTag::External) | Code |
+                    (static_cast<uint64_t>(*Types[Idx]->getCanonicalID())
+                     << 32));
+    } else {
+      IsValid = false;
+    }
+  };
+
+  Key.push_back(Size);
+  for (uint32_t I = StartIdx; I < StartIdx + Size; I++) {
+    const auto *Type = Types[I];
+    Key.push_back(Type->isFinal() ? 1U : 0U);
+    Key.push_back(Type->getSuperTypeIndices().size());
+    for (auto SIdx : Type->getSuperTypeIndices()) {
+      encodeValType(ValType(TypeCode::Ref, SIdx));
+    }
+    const auto &CompType = Type->getCompositeType();
+    Key.push_back(static_cast<uint64_t>(CompType.getContentTypeCode()));
+    if (CompType.isFunc()) {
+      const auto &FType = CompType.getFuncType();
+      Key.push_back(FType.getParamTypes().size());
+      for (const auto &VT : FType.getParamTypes()) {
+        encodeValType(VT);
+      }
+      Key.push_back(FType.getReturnTypes().size());
+      for (const auto &VT : FType.getReturnTypes()) {
+        encodeValType(VT);
+      }
+    } else {
+      Key.push_back(CompType.getFieldTypes().size());
+      for (const auto &FType : CompType.getFieldTypes()) {
+        Key.push_back(static_cast<uint64_t>(FType.getValMut()));
+        encodeValType(FType.getStorageType());
+      }
+    }
+  }
+  if (!IsValid) {
+    return std::nullopt;
+  }
+  return Key;
+}
+
+} // namespace
+
+// Instantiate defined types. See "include/executor/executor.h".
+Expect<void> Executor::instantiate(Runtime::Instance::ModuleInstance &ModInst,
+                                   const AST::TypeSection &TypeSec) {
+  // Copy defined types to module instance.
+  for (const auto &SubType : TypeSec.getContent()) {
+    ModInst.addDefinedType(SubType);
+  }
+  // Assign the canonical IDs for matching types across modules in runtime.
+  canonicalizeTypes(ModInst);
+  return {};
+}
+
+// Assign canonical type IDs. See "include/executor/executor.h".
+void Executor::canonicalizeTypes(
+    const Runtime::Instance::ModuleInstance &ModInst) {
+  std::unique_lock Lock(ModInst.Mutex);
+  Span<const AST::SubType *const> Types = ModInst.Types;
+  const uint32_t TypeNum = static_cast<uint32_t>(Types.size());
+  uint32_t Idx = 0;
+  while (Idx < TypeNum) {
+    // A single subtype is seemed as a self-recursive type.
+    const auto RecInfo = Types[Idx]->getRecursiveInfo();
+    uint32_t Size = 1;
+    if (RecInfo.has_value() && RecInfo->RecTypeSize > 1) {
+      if (unlikely(RecInfo->Index != 0 ||
+                   Idx + RecInfo->RecTypeSize > TypeNum)) {
+        // Not the start of a complete recursive type. Leave it to the
+        // structural matching.
+        Idx++;
+        continue;
+      }
+      Size = RecInfo->RecTypeSize;
+    }
+    if (Types[Idx]->getCanonicalID().has_value()) {
+      // Already canonicalized, such as the host function types.
+      Idx += Size;
+      continue;
+    }
+    if (auto Key = encodeRecGroup(Types, Idx, Size)) {
+      const uint32_t Base =
+          TypeRegistry::getInstance().intern(std::move(*Key), Size);
+      for (uint32_t I = 0; I < Size; I++) {
+        const_cast<AST::SubType *>(Types[Idx + I])->setCanonicalID(Base + I);
+      }
+    }
+    Idx += Size;
+  }
+}
+
+} // namespace Executor
+} // namespace WasmEdge
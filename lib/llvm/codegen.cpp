@@ -3,16 +3,20 @@
 
 #include "llvm/codegen.h"
 
+#include "aot/target.h"
 #include "aot/version.h"
 #include "common/defines.h"
+#include "common/threadpool.h"
 #include "data.h"
 #include "llvm.h"
 
 #include <charconv>
 #include <fstream>
+#include <optional>
 #include <lld/Common/Driver.h>
 #include <random>
 #include <sstream>
+#include <thread>
 
 #if LLVM_VERSION_MAJOR >= 14
 #include <lld/Common/CommonLinkerContext.h>
@@ -176,12 +180,20 @@ std::filesystem::path createTemp(const std::filesystem::path Model) noexcept {
   }
 }
 
-// Write output object and link
-Expect<void> outputNativeLibrary(const std::filesystem::path &OutputPath,
-                                 const LLVM::MemoryBuffer &OSVec) noexcept {
+// Write output objects of the partitions and link them in order
+Expect<void>
+outputNativeLibrary(const std::filesystem::path &OutputPath,
+                    Span<const LLVM::MemoryBuffer> OSVecs) noexcept {
   spdlog::info("output start");
-  std::filesystem::path ObjectName;
-  {
+  std::vector<std::filesystem::path> ObjectNames;
+  std::vector<std::string> ObjectArgs;
+  auto RemoveObjects = [&ObjectNames]() noexcept {
+    std::error_code Error;
+    for (const auto &ObjectName : ObjectNames) {
+      std::filesystem::remove(ObjectName, Error);
+    }
+  };
+  for (const auto &OSVec : OSVecs) {
     // tempfile
     std::filesystem::path OPath(OutputPath);
 #if WASMEDGE_OS_WINDOWS
@@ -189,15 +201,18 @@ Expect<void> outputNativeLibrary(const std::filesystem::path &OutputPath,
 #else
     OPath.replace_extension("%%%%%%%%%%.o"sv);
 #endif
-    ObjectName = createTemp(OPath);
+    auto ObjectName = createTemp(OPath);
     if (ObjectName.empty()) {
       // TODO:return error
       spdlog::error("so file creation failed:{}", OPath.u8string());
+      RemoveObjects();
       return Unexpect(ErrCode::Value::IllegalPath);
     }
     std::ofstream OS(ObjectName, std::ios_base::binary);
     OS.write(OSVec.data(), static_cast<std::streamsize>(OSVec.size()));
     OS.close();
+    ObjectArgs.push_back(ObjectName.u8string());
+    ObjectNames.push_back(std::move(ObjectName));
   }
 
   // link
@@ -209,12 +224,13 @@ Expect<void> outputNativeLibrary(const std::filesystem::path &OutputPath,
   // LLVM 14 replaces the older mach_o lld implementation with the new one.
   // So we need to change the namespace after LLVM 14.x released.
   // Reference: https://reviews.llvm.org/D114842
-  LinkResult = lld::macho::link(
+  auto Link = lld::macho::link;
 #else
-  LinkResult = lld::mach_o::link(
+  auto Link = lld::mach_o::link;
 #endif
-      std::initializer_list<const char *> {
-        "lld", "-arch",
+  const auto OutputName = OutputPath.u8string();
+  std::vector<const char *> Args {
+    "lld", "-arch",
 #if defined(__x86_64__)
             "x86_64",
 #elif defined(__aarch64__)
@@ -232,23 +248,26 @@ Expect<void> outputNativeLibrary(const std::filesystem::path &OutputPath,
 #endif
             "-dylib", "-demangle", "-macosx_version_min", OSVersion.c_str(),
             "-syslibroot",
-            "/Library/Developer/CommandLineTools/SDKs/MacOSX.sdk",
-            ObjectName.u8string().c_str(), "-o", OutputPath.u8string().c_str()
-      },
+            "/Library/Developer/CommandLineTools/SDKs/MacOSX.sdk", "-o",
+            OutputName.c_str()
+  };
 #elif WASMEDGE_OS_LINUX
-  LinkResult = lld::elf::link(
-      std::initializer_list<const char *>{"ld.lld", "--eh-frame-hdr",
-                                          "--shared", "--gc-sections",
-                                          "--discard-all", ObjectName.c_str(),
-                                          "-o", OutputPath.u8string().c_str()},
+  auto Link = lld::elf::link;
+  const auto OutputName = OutputPath.u8string();
+  std::vector<const char *> Args{"ld.lld",        "--eh-frame-hdr",
+                                 "--shared",      "--gc-sections",
+                                 "--discard-all", "-o",
+                                 OutputName.c_str()};
 #elif WASMEDGE_OS_WINDOWS
-  LinkResult = lld::coff::link(
-      std::initializer_list<const char *>{
-          "lld-link", "-dll", "-base:0", "-nologo",
-          ObjectName.u8string().c_str(),
-          ("-out:" + OutputPath.u8string()).c_str()},
+  auto Link = lld::coff::link;
+  const auto OutputName = "-out:" + OutputPath.u8string();
+  std::vector<const char *> Args{"lld-link", "-dll", "-base:0", "-nologo",
+                                 OutputName.c_str()};
 #endif
-
+  for (const auto &ObjectArg : ObjectArgs) {
+    Args.push_back(ObjectArg.c_str());
+  }
+  LinkResult = Link(Args,
 #if LLVM_VERSION_MAJOR >= 14
       llvm::outs(), llvm::errs(), false, false
 #elif LLVM_VERSION_MAJOR >= 10
@@ -263,9 +282,9 @@ Expect<void> outputNativeLibrary(const std::filesystem::path &OutputPath,
 #endif
 
   if (LinkResult) {
-    std::error_code Error;
-    std::filesystem::remove(ObjectName, Error);
+    RemoveObjects();
 #if WASMEDGE_OS_WINDOWS
+    std::error_code Error;
     std::filesystem::path LibPath(OutputPath);
     LibPath.replace_extension(".lib"sv);
     std::filesystem::remove(LibPath, Error);
@@ -299,10 +318,13 @@ Expect<void> outputNativeLibrary(const std::filesystem::path &OutputPath,
   return {};
 }
 
-Expect<void> outputWasmLibrary(LLVM::Context LLContext,
-                               const std::filesystem::path &OutputPath,
-                               Span<const Byte> Data,
-                               const LLVM::MemoryBuffer &OSVec) noexcept {
+// Link the output objects of a target level, and create the AOT section
+// content from the linked library
+Expect<std::string>
+createAOTSection(LLVM::Context LLContext,
+                 const std::filesystem::path &OutputPath,
+                 Span<const LLVM::MemoryBuffer> OSVecs,
+                 AOT::TargetLevel Level) noexcept {
   std::filesystem::path SharedObjectName;
   {
     // tempfile
@@ -314,12 +336,10 @@ Expect<void> outputWasmLibrary(LLVM::Context LLContext,
       spdlog::error("so file creation failed:{}", SOPath.u8string());
       return Unexpect(ErrCode::Value::IllegalPath);
     }
-    std::ofstream OS(SharedObjectName, std::ios_base::binary);
-    OS.write(OSVec.data(), static_cast<std::streamsize>(OSVec.size()));
-    OS.close();
   }
 
-  if (auto Res = outputNativeLibrary(SharedObjectName, OSVec); unlikely(!Res)) {
+  if (auto Res = outputNativeLibrary(SharedObjectName, OSVecs);
+      unlikely(!Res)) {
     return Unexpect(Res);
   }
 
@@ -370,6 +390,8 @@ Expect<void> outputWasmLibrary(LLVM::Context LLContext,
 #error Unsupported hardware architecture!
 #endif
 
+    WriteByte(OS, static_cast<uint8_t>(Level));
+
     std::vector<std::pair<std::string, uint64_t>> SymbolTable;
 #if !WASMEDGE_OS_WINDOWS
     for (auto Symbol = ObjFile.symbols();
@@ -480,6 +502,16 @@ Expect<void> outputWasmLibrary(LLVM::Context LLContext,
     OSCustomSecVec = OS.str();
   }
 
+  std::error_code Error;
+  std::filesystem::remove(SharedObjectName, Error);
+
+  return OSCustomSecVec;
+}
+
+// Write the wasm and the AOT sections of the target levels
+Expect<void> outputWasmLibrary(const std::filesystem::path &OutputPath,
+                               Span<const Byte> Data,
+                               Span<const std::string> AOTSections) noexcept {
   spdlog::info("output start");
 
   std::ofstream OS(OutputPath, std::ios_base::binary);
@@ -489,31 +521,24 @@ Expect<void> outputWasmLibrary(LLVM::Context LLContext,
   }
   OS.write(reinterpret_cast<const char *>(Data.data()),
            static_cast<std::streamsize>(Data.size()));
-  // Custom section id
-  WriteByte(OS, UINT8_C(0x00));
-  WriteName(OS, std::string_view(OSCustomSecVec.data(), OSCustomSecVec.size()));
-
-  std::error_code Error;
-  std::filesystem::remove(SharedObjectName, Error);
+  for (const auto &AOTSection : AOTSections) {
+    // Custom section id
+    WriteByte(OS, UINT8_C(0x00));
+    WriteName(OS, AOTSection);
+  }
 
   spdlog::info("output done");
   return {};
 }
 
-} // namespace
-
-namespace WasmEdge::LLVM {
-
-Expect<void> CodeGen::codegen(Span<const Byte> WasmData, Data D,
-                              std::filesystem::path OutputPath) noexcept {
-  auto LLContext = D.extract().LLContext();
-  auto &LLModule = D.extract().LLModule;
-  auto &TM = D.extract().TM;
-  std::filesystem::path LLPath(OutputPath);
-  LLPath.replace_extension("ll"sv);
-
+// Set up the linkages and the exports of the main module and the function
+// partitions. Returns the modules in the link order.
+std::vector<LLVM::Data::DataContext *>
+prepareModules(const Configure &Conf, LLVM::Data &D) noexcept {
 #if WASMEDGE_OS_WINDOWS
   {
+    auto LLContext = D.extract().LLContext();
+    auto &LLModule = D.extract().LLModule;
     // create dummy dllmain function
     auto FTy = LLVM::Type::getFunctionType(LLContext.getInt32Ty(), {});
     auto F =
@@ -538,14 +563,113 @@ Expect<void> CodeGen::codegen(Span<const Byte> WasmData, Data D,
     A.setDSOLocal(true);
   }
 #endif
+
+  // The main module and the other function partitions, in the link order.
+  std::vector<LLVM::Data::DataContext *> Contexts = {&D.extract()};
+  for (auto &Partition : D.extract().Partitions) {
+    Contexts.push_back(&Partition.extract());
+  }
+
 #if WASMEDGE_OS_MACOS
-  {
+  for (auto *Context : Contexts) {
     const auto [Major, Minor] = getSDKVersionPair();
-    LLModule.addFlag(LLVMModuleFlagBehaviorError, "SDK Version"sv,
-                     LLVM::Value::getConstVector32(LLContext, {Major, Minor}));
+    Context->LLModule.addFlag(
+        LLVMModuleFlagBehaviorError, "SDK Version"sv,
+        LLVM::Value::getConstVector32(Context->LLContext(), {Major, Minor}));
   }
 #endif
 
+  for (auto *Context : Contexts) {
+    auto &M = Context->LLModule;
+    if (Conf.getCompilerConfigure().getOutputFormat() !=
+        CompilerConfigure::OutputFormat::Wasm) {
+      for (auto Fn = M.getFirstFunction(); Fn; Fn = Fn.getNextFunction()) {
+        if (Fn.getLinkage() == LLVMInternalLinkage) {
+          Fn.setLinkage(LLVMExternalLinkage);
+          Fn.setVisibility(LLVMProtectedVisibility);
+          Fn.setDSOLocal(true);
+          Fn.setDLLStorageClass(LLVMDLLExportStorageClass);
+        }
+      }
+    } else {
+      for (auto Fn = M.getFirstFunction(); Fn; Fn = Fn.getNextFunction()) {
+        if (Fn.getLinkage() == LLVMInternalLinkage) {
+          Fn.setLinkage(LLVMPrivateLinkage);
+          Fn.setDSOLocal(true);
+          Fn.setDLLStorageClass(LLVMDefaultStorageClass);
+        }
+      }
+    }
+
+    // set dllexport, except the declarations defined in the other partitions
+    for (auto GV = M.getFirstGlobal(); GV; GV = GV.getNextGlobal()) {
+      if (GV.getLinkage() == LLVMExternalLinkage && GV.getInitializer()) {
+        GV.setVisibility(LLVMProtectedVisibility);
+        GV.setDSOLocal(true);
+        GV.setDLLStorageClass(LLVMDLLExportStorageClass);
+      }
+    }
+  }
+  return Contexts;
+}
+
+// Emit the objects of the modules in parallel. Each module has its own context
+// and target machine.
+Expect<std::vector<LLVM::MemoryBuffer>>
+emitObjects(const Configure &Conf,
+            Span<LLVM::Data::DataContext *const> Contexts) noexcept {
+  std::vector<std::pair<LLVM::MemoryBuffer, LLVM::Message>> Results(
+      Contexts.size());
+  auto Emit = [&Contexts, &Results](size_t I) noexcept {
+    Results[I] = Contexts[I]->TM.emitToMemoryBuffer(Contexts[I]->LLModule,
+                                                    LLVMObjectFile);
+  };
+  {
+    uint32_t ThreadNum = Conf.getCompilerConfigure().getCompileThreadNum();
+    if (ThreadNum == 0) {
+      ThreadNum = std::max(std::thread::hardware_concurrency(), 1U);
+    }
+    const auto WorkerNum = static_cast<uint32_t>(
+        std::min<size_t>(ThreadNum, Contexts.size()) - 1);
+    std::optional<ThreadPool> Pool;
+    if (WorkerNum > 0) {
+      Pool.emplace(WorkerNum);
+      for (size_t I = 1; I < Contexts.size(); ++I) {
+        Pool->submit([&Emit, I]() { Emit(I); });
+      }
+    }
+    Emit(0);
+    if (!Pool) {
+      for (size_t I = 1; I < Contexts.size(); ++I) {
+        Emit(I);
+      }
+    }
+  }
+
+  std::vector<LLVM::MemoryBuffer> OSVecs;
+  OSVecs.reserve(Results.size());
+  for (auto &[OSVec, ErrorMessage] : Results) {
+    if (ErrorMessage) {
+      // TODO:return error
+      spdlog::error("addPassesToEmitFile failed");
+      return Unexpect(ErrCode::Value::IllegalPath);
+    }
+    OSVecs.push_back(std::move(OSVec));
+  }
+  return OSVecs;
+}
+
+} // namespace
+
+namespace WasmEdge::LLVM {
+
+Expect<void> CodeGen::codegen(Span<const Byte> WasmData, Data D,
+                              std::filesystem::path OutputPath) noexcept {
+  auto LLContext = D.extract().LLContext();
+  auto &LLModule = D.extract().LLModule;
+  std::filesystem::path LLPath(OutputPath);
+  LLPath.replace_extension("ll"sv);
+
   if (Conf.getCompilerConfigure().getOutputFormat() !=
       CompilerConfigure::OutputFormat::Wasm) {
     // create wasm.code and wasm.size
@@ -559,32 +683,9 @@ Expect<void> CodeGen::codegen(Span<const Byte> WasmData, Data D,
     LLModule.addGlobal(Int32Ty, true, LLVMExternalLinkage,
                        LLVM::Value::getConstInt(Int32Ty, WasmData.size()),
                        "wasm.size");
-    for (auto Fn = LLModule.getFirstFunction(); Fn; Fn = Fn.getNextFunction()) {
-      if (Fn.getLinkage() == LLVMInternalLinkage) {
-        Fn.setLinkage(LLVMExternalLinkage);
-        Fn.setVisibility(LLVMProtectedVisibility);
-        Fn.setDSOLocal(true);
-        Fn.setDLLStorageClass(LLVMDLLExportStorageClass);
-      }
-    }
-  } else {
-    for (auto Fn = LLModule.getFirstFunction(); Fn; Fn = Fn.getNextFunction()) {
-      if (Fn.getLinkage() == LLVMInternalLinkage) {
-        Fn.setLinkage(LLVMPrivateLinkage);
-        Fn.setDSOLocal(true);
-        Fn.setDLLStorageClass(LLVMDefaultStorageClass);
-      }
-    }
   }
 
-  // set dllexport
-  for (auto GV = LLModule.getFirstGlobal(); GV; GV = GV.getNextGlobal()) {
-    if (GV.getLinkage() == LLVMExternalLinkage) {
-      GV.setVisibility(LLVMProtectedVisibility);
-      GV.setDSOLocal(true);
-      GV.setDLLStorageClass(LLVMDLLExportStorageClass);
-    }
-  }
+  const auto Contexts = prepareModules(Conf, D);
 
   if (Conf.getCompilerConfigure().isDumpIR()) {
     if (auto ErrorMessage = LLModule.printModuleToFile("wasm.ll");
@@ -603,24 +704,57 @@ Expect<void> CodeGen::codegen(Span<const Byte> WasmData, Data D,
         spdlog::error("printModuleToFile failed");
         return Unexpect(ErrCode::Value::IllegalPath);
       }
+      for (size_t I = 1; I < Contexts.size(); ++I) {
+        const auto Name = fmt::format("wasm-opt-{}.ll"sv, I);
+        if (auto ErrorMessage =
+                Contexts[I]->LLModule.printModuleToFile(Name.c_str())) {
+          spdlog::error("printModuleToFile failed");
+          return Unexpect(ErrCode::Value::IllegalPath);
+        }
+      }
     }
 
-    auto [OSVec, ErrorMessage] =
-        TM.emitToMemoryBuffer(LLModule, LLVMObjectFile);
-    if (ErrorMessage) {
-      // TODO:return error
-      spdlog::error("addPassesToEmitFile failed");
-      return Unexpect(ErrCode::Value::IllegalPath);
+    auto OSVecs = emitObjects(Conf, Contexts);
+    if (unlikely(!OSVecs)) {
+      return Unexpect(OSVecs);
     }
 
     if (Conf.getCompilerConfigure().getOutputFormat() ==
         CompilerConfigure::OutputFormat::Wasm) {
-      if (auto Res = outputWasmLibrary(LLContext, OutputPath, WasmData, OSVec);
+      // The AOT sections of the fat binary variants follow the main one in the
+      // ascending order of the target levels.
+      std::vector<std::string> AOTSections;
+      if (auto Res = createAOTSection(LLContext, OutputPath, *OSVecs,
+                                      D.extract().Target);
+          unlikely(!Res)) {
+        return Unexpect(Res);
+      } else {
+        AOTSections.push_back(std::move(*Res));
+      }
+      for (auto &Variant : D.extract().Variants) {
+        spdlog::info("codegen for target {}"sv,
+                     AOT::getTargetCPUName(Variant.extract().Target));
+        auto VariantOSVecs =
+            emitObjects(Conf, prepareModules(Conf, Variant));
+        if (unlikely(!VariantOSVecs)) {
+          return Unexpect(VariantOSVecs);
+        }
+        if (auto Res = createAOTSection(Variant.extract().LLContext(),
+                                        OutputPath, *VariantOSVecs,
+                                        Variant.extract().Target);
+            unlikely(!Res)) {
+          return Unexpect(Res);
+        } else {
+          AOTSections.push_back(std::move(*Res));
+        }
+      }
+      if (auto Res = outputWasmLibrary(OutputPath, WasmData, AOTSections);
           unlikely(!Res)) {
         return Unexpect(Res);
       }
     } else {
-      if (auto Res = outputNativeLibrary(OutputPath, OSVec); unlikely(!Res)) {
+      if (auto Res = outputNativeLibrary(OutputPath, *OSVecs);
+          unlikely(!Res)) {
         return Unexpect(Res);
       }
     }
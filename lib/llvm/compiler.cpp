@@ -3,10 +3,13 @@
 
 #include "llvm/compiler.h"
 
+#include "aot/target.h"
 #include "aot/version.h"
 #include "common/defines.h"
 #include "common/filesystem.h"
 #include "common/spdlog.h"
+#include "common/threadpool.h"
+#include "common/version.h"
 #include "data.h"
 #include "llvm.h"
 
@@ -16,11 +19,15 @@
 #include <cstdint>
 #include <cstdlib>
 #include <limits>
+#include <map>
 #include <memory>
 #include <numeric>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <system_error>
+#include <thread>
+#include <unordered_map>
 
 namespace LLVM = WasmEdge::LLVM;
 using namespace std::literals;
@@ -57,6 +64,15 @@ static inline constexpr const bool kForceDivCheck = true;
 // Size of a ValVariant
 static inline constexpr const uint32_t kValSize = sizeof(WasmEdge::ValVariant);
 
+// Minimum code size in bytes of a function partition, and the maximum
+// partition count of a module
+static inline constexpr const uint64_t kPartitionCodeSize = UINT64_C(256)
+                                                            << 10;
+static inline constexpr const size_t kMaxPartitions = 64;
+
+// Size of a memory page
+static inline constexpr const uint64_t kPageSize = UINT64_C(65536);
+
 // Translate Compiler::OptimizationLevel to llvm::PassBuilder version
 #if LLVM_VERSION_MAJOR >= 13
 static inline const char *
@@ -202,8 +218,25 @@ struct LLVM::Compiler::CompileContext {
   std::vector<LLVM::Type> Globals;
   LLVM::Value IntrinsicsTable;
   LLVM::FunctionCallee Trap;
-  CompileContext(LLVM::Context C, LLVM::Module &M,
-                 bool IsGenericBinary) noexcept
+  /// The main partition holds the type wrappers and the version. The other
+  /// partitions only compile the defined functions [FuncBegin, FuncEnd).
+  bool IsMainPartition;
+  /// Compile the functions alone for the tiered execution. The calls to the
+  /// other functions go through the executor.
+  bool IsStandalone = false;
+  size_t FuncBegin = 0;
+  size_t FuncEnd = std::numeric_limits<size_t>::max();
+  /// Execution profile for the profile-guided optimization, or nullptr.
+  const Profile *Prof = nullptr;
+  /// Minimum sizes in bytes of the memories. The memories never shrink, so the
+  /// accesses below them are always in bounds.
+  std::vector<uint64_t> MemoryMinSizes;
+  /// Counts of the memory accesses, and the ones proven in bounds which are
+  /// not relied on the guard region.
+  uint64_t MemoryAccessCount = 0;
+  uint64_t InBoundsAccessCount = 0;
+  CompileContext(LLVM::Context C, LLVM::Module &M, AOT::TargetLevel Target,
+                 bool IsMainPartition = true) noexcept
       : LLContext(C), LLModule(M),
         Cold(LLVM::Attribute::createEnum(C, LLVM::Core::Cold, 0)),
         NoAlias(LLVM::Attribute::createEnum(C, LLVM::Core::NoAlias, 0)),
@@ -245,8 +278,10 @@ struct LLVM::Compiler::CompileContext {
                 Int64PtrTy,
                 // GasLimit
                 Int64Ty,
-                // StopToken
-                Int32PtrTy,
+                // Epoch
+                Int64PtrTy,
+                // Deadline
+                Int64PtrTy,
             })),
         ExecCtxPtrTy(ExecCtxTy.getPointerTo()),
         IntrinsicsTableTy(LLVM::Type::getArrayType(
@@ -255,7 +290,8 @@ struct LLVM::Compiler::CompileContext {
         IntrinsicsTablePtrTy(IntrinsicsTableTy.getPointerTo()),
         IntrinsicsTable(LLModule.addGlobal(IntrinsicsTablePtrTy, true,
                                            LLVMExternalLinkage, LLVM::Value(),
-                                           "intrinsics")) {
+                                           "intrinsics")),
+        IsMainPartition(IsMainPartition) {
     Trap.Ty = LLVM::Type::getFunctionType(VoidTy, {Int32Ty});
     Trap.Fn = LLModule.addFunction(Trap.Ty, LLVMPrivateLinkage, "trap");
     Trap.Fn.setDSOLocal(true);
@@ -266,11 +302,13 @@ struct LLVM::Compiler::CompileContext {
     Trap.Fn.addFnAttr(Cold);
     Trap.Fn.addFnAttr(NoInline);
 
-    LLModule.addGlobal(Int32Ty, true, LLVMExternalLinkage,
-                       LLVM::Value::getConstInt(Int32Ty, AOT::kBinaryVersion),
-                       "version");
+    if (IsMainPartition) {
+      LLModule.addGlobal(
+          Int32Ty, true, LLVMExternalLinkage,
+          LLVM::Value::getConstInt(Int32Ty, AOT::kBinaryVersion), "version");
+    }
 
-    if (!IsGenericBinary) {
+    if (Target == AOT::TargetLevel::Host) {
       SubtargetFeatures = LLVM::getHostCPUFeatures();
       auto Features = SubtargetFeatures.string_view();
       while (!Features.empty()) {
@@ -306,6 +344,13 @@ struct LLVM::Compiler::CompileContext {
 #endif
       }
     }
+#if defined(__x86_64__)
+    if (Target != AOT::TargetLevel::Host &&
+        Target >= AOT::TargetLevel::X86_64_V2) {
+      // The x86-64-v2 and above levels have SSSE3 and SSE4.1.
+      SupportSSE4_1 = SupportSSSE3 = SupportSSE2 = true;
+    }
+#endif
 
     {
       // create trap
@@ -358,10 +403,111 @@ struct LLVM::Compiler::CompileContext {
                           LLVM::Value ExecCtx) noexcept {
     return Builder.createExtractValue(ExecCtx, 5);
   }
-  LLVM::Value getStopToken(LLVM::Builder &Builder,
-                           LLVM::Value ExecCtx) noexcept {
+  LLVM::Value getEpoch(LLVM::Builder &Builder, LLVM::Value ExecCtx) noexcept {
     return Builder.createExtractValue(ExecCtx, 6);
   }
+  LLVM::Value getDeadline(LLVM::Builder &Builder,
+                          LLVM::Value ExecCtx) noexcept {
+    return Builder.createExtractValue(ExecCtx, 7);
+  }
+  LLVM::FunctionCallee getFunction(uint32_t Index) noexcept {
+    auto &F = std::get<1>(Functions[Index]);
+    if (!F.Fn && IsStandalone) {
+      // Not compiled with this function. Call it through the executor.
+      F = createCallThunk(Index, std::get<0>(Functions[Index]),
+                          LLVMPrivateLinkage);
+    } else if (!F.Fn) {
+      // Defined in the other partition. Declare it on the first use.
+      const auto &FuncType = *FunctionTypes[std::get<0>(Functions[Index])];
+      F.Ty = toLLVMType(LLContext, ExecCtxPtrTy, FuncType);
+      F.Fn = LLModule.addFunction(F.Ty, LLVMExternalLinkage,
+                                  fmt::format("f{}"sv, Index).c_str());
+      F.Fn.addFnAttr(NoStackArgProbe);
+      F.Fn.addFnAttr(StrictFP);
+      F.Fn.addFnAttr(UWTable);
+      F.Fn.addParamAttr(0, ReadOnly);
+      F.Fn.addParamAttr(0, NoAlias);
+    }
+    return F;
+  }
+  /// Create the function which calls the function FuncID through the
+  /// executor, for the imported functions and the standalone compiling.
+  LLVM::FunctionCallee createCallThunk(uint32_t FuncID, uint32_t TypeIdx,
+                                       LLVMLinkage Linkage) noexcept {
+    const auto &FuncType = *FunctionTypes[TypeIdx];
+    auto FTy = toLLVMType(LLContext, ExecCtxPtrTy, FuncType);
+    auto RTy = FTy.getReturnType();
+    auto F = LLVM::FunctionCallee{
+        FTy, LLModule.addFunction(FTy, Linkage,
+                                  fmt::format("f{}"sv, FuncID).c_str())};
+    F.Fn.setDSOLocal(true);
+    F.Fn.addFnAttr(NoStackArgProbe);
+    F.Fn.addFnAttr(StrictFP);
+    F.Fn.addFnAttr(UWTable);
+    F.Fn.addParamAttr(0, ReadOnly);
+    F.Fn.addParamAttr(0, NoAlias);
+
+    LLVM::Builder Builder(LLContext);
+    Builder.positionAtEnd(LLVM::BasicBlock::create(LLContext, F.Fn, "entry"));
+
+    const auto ArgSize = FuncType.getParamTypes().size();
+    const auto RetSize = RTy.isVoidTy() ? 0 : FuncType.getReturnTypes().size();
+
+    LLVM::Value Args;
+    if (ArgSize == 0) {
+      Args = LLVM::Value::getConstNull(Int8PtrTy);
+    } else {
+      auto Alloca = Builder.createArrayAlloca(
+          Int8Ty, LLContext.getInt64(ArgSize * kValSize));
+      Alloca.setAlignment(kValSize);
+      Args = Alloca;
+    }
+
+    LLVM::Value Rets;
+    if (RetSize == 0) {
+      Rets = LLVM::Value::getConstNull(Int8PtrTy);
+    } else {
+      auto Alloca = Builder.createArrayAlloca(
+          Int8Ty, LLContext.getInt64(RetSize * kValSize));
+      Alloca.setAlignment(kValSize);
+      Rets = Alloca;
+    }
+
+    auto Arg = F.Fn.getFirstParam();
+    for (unsigned I = 0; I < ArgSize; ++I) {
+      Arg = Arg.getNextParam();
+      LLVM::Value Ptr =
+          Builder.createConstInBoundsGEP1_64(Int8Ty, Args, I * kValSize);
+      Builder.createStore(
+          Arg, Builder.createBitCast(Ptr, Arg.getType().getPointerTo()));
+    }
+
+    Builder.createCall(
+        getIntrinsic(Builder, Executable::Intrinsics::kCall,
+                     LLVM::Type::getFunctionType(
+                         VoidTy, {Int32Ty, Int8PtrTy, Int8PtrTy}, false)),
+        {LLContext.getInt32(FuncID), Args, Rets});
+
+    if (RetSize == 0) {
+      Builder.createRetVoid();
+    } else if (RetSize == 1) {
+      LLVM::Value VPtr = Builder.createConstInBoundsGEP1_64(Int8Ty, Rets, 0);
+      LLVM::Value Ptr = Builder.createBitCast(VPtr, RTy.getPointerTo());
+      Builder.createRet(Builder.createLoad(RTy, Ptr));
+    } else {
+      std::vector<LLVM::Value> Ret;
+      Ret.reserve(RetSize);
+      for (unsigned I = 0; I < RetSize; ++I) {
+        LLVM::Value VPtr =
+            Builder.createConstInBoundsGEP1_64(Int8Ty, Rets, I * kValSize);
+        LLVM::Value Ptr = Builder.createBitCast(
+            VPtr, RTy.getStructElementType(I).getPointerTo());
+        Ret.push_back(Builder.createLoad(RTy.getStructElementType(I), Ptr));
+      }
+      Builder.createAggregateRet(Ret);
+    }
+    return F;
+  }
   LLVM::FunctionCallee getIntrinsic(LLVM::Builder &Builder,
                                     Executable::Intrinsics Index,
                                     LLVM::Type Ty) noexcept {
@@ -511,6 +657,8 @@ public:
       if (GasMeasuring) {
         LocalGas = Builder.createAlloca(Context.Int64Ty);
         Builder.createStore(LLContext.getInt64(0), LocalGas);
+        LocalGasBudget = Builder.createAlloca(Context.Int64Ty);
+        resetGasBudget();
       }
 
       for (LLVM::Value Arg = F.Fn.getFirstParam().getNextParam(); Arg;
@@ -527,6 +675,10 @@ public:
         Builder.createStore(toLLVMConstantZero(LLContext, Type), ArgPtr);
         Local.emplace_back(Ty, ArgPtr);
       }
+
+      LocalVersion.resize(Local.size());
+      std::iota(LocalVersion.begin(), LocalVersion.end(), UINT32_C(0));
+      NextLocalVersion = static_cast<uint32_t>(Local.size());
     }
   }
 
@@ -545,12 +697,40 @@ public:
     auto RetBB = LLVM::BasicBlock::create(LLContext, F.Fn, "ret");
     Type.first.clear();
     enterBlock(RetBB, {}, {}, {}, std::move(Type));
+    if (LocalGas) {
+      // Load the costs of the opcodes once in the entry block. The costs of
+      // the straight line code are summed up from them, which are hoisted out
+      // of the loops.
+      auto CostTable = Context.getCostTable(Builder, ExecCtx);
+      for (const auto &Instr : Code.getExpr().getInstrs()) {
+        auto [It, Inserted] = OpCosts.try_emplace(Instr.getOpCode());
+        if (!Inserted) {
+          continue;
+        }
+        It->second = Builder.createLoad(
+            Context.Int64Ty,
+            Builder.createConstInBoundsGEP2_64(
+                LLVM::Type::getArrayType(Context.Int64Ty, UINT16_MAX + 1),
+                CostTable, 0, static_cast<uint16_t>(Instr.getOpCode())));
+        // The cost table is not changed in the execution.
+        It->second.setMetadata(LLContext, LLVM::Core::InvariantLoad,
+                               LLVM::Metadata(LLContext, {}));
+      }
+    }
+    checkStop();
     compile(Code.getExpr().getInstrs());
     assuming(ControlStack.empty());
     compileReturn();
 
     for (auto &[Error, BB] : TrapBB) {
       Builder.positionAtEnd(BB);
+      if (Error == ErrCode::Value::Interrupted) {
+        // Clear the deadline for the later executions.
+        auto Store = Builder.createStore(LLContext.getInt64(UINT64_MAX),
+                                         Context.getDeadline(Builder, ExecCtx));
+        Store.setAlignment(8);
+        Store.setOrdering(LLVMAtomicOrderingMonotonic);
+      }
       updateInstrCount();
       updateGasAtTrap();
       auto CallTrap = Builder.createCall(
@@ -584,11 +764,17 @@ public:
           }
         }
         enterBlock(EndBlock, {}, {}, std::move(Args), std::move(Type));
-        checkStop();
-        updateGas();
         return;
       }
       case OpCode::Loop: {
+        // The locals written in the loop body hold the other values in the
+        // next iterations.
+        for (auto *It = &Instr + 1; It < &Instr + Instr.getJumpEnd(); ++It) {
+          if (It->getOpCode() == OpCode::Local__set ||
+              It->getOpCode() == OpCode::Local__tee) {
+            LocalVersion[It->getTargetIndex()] = NextLocalVersion++;
+          }
+        }
         auto Curr = Builder.getInsertBlock();
         auto Loop = LLVM::BasicBlock::create(LLContext, F.Fn, "loop");
         auto EndLoop = LLVM::BasicBlock::create(LLContext, F.Fn, "loop.end");
@@ -617,7 +803,7 @@ public:
         }
         enterBlock(Loop, EndLoop, {}, std::move(Args), std::move(Type));
         checkStop();
-        updateGas();
+        checkGas();
         return;
       }
       case OpCode::If: {
@@ -630,7 +816,10 @@ public:
         } else {
           Cond = Builder.createICmpNE(stackPop(), LLContext.getInt32(0));
         }
-        Builder.createCondBr(Cond, Then, Else);
+        auto Br = Builder.createCondBr(Cond, Then, Else);
+        if (!isUnreachable()) {
+          setBranchWeights(Br, Instr.getOffset());
+        }
 
         Builder.positionAtEnd(Then);
         auto Type = Context.resolveBlockType(Instr.getBlockType());
@@ -706,7 +895,8 @@ public:
         auto Cond = Builder.createICmpNE(stackPop(), LLContext.getInt32(0));
         setLableJumpPHI(Label);
         auto Next = LLVM::BasicBlock::create(LLContext, F.Fn, "br_if.end");
-        Builder.createCondBr(Cond, getLabel(Label), Next);
+        auto Br = Builder.createCondBr(Cond, getLabel(Label), Next);
+        setBranchWeights(Br, Instr.getOffset());
         Builder.positionAtEnd(Next);
         break;
       }
@@ -762,11 +952,13 @@ public:
         updateInstrCount();
         updateGas();
         compileCallOp(Instr.getTargetIndex());
+        resetGasBudget();
         break;
       case OpCode::Call_indirect:
         updateInstrCount();
         updateGas();
         compileIndirectCallOp(Instr.getSourceIndex(), Instr.getTargetIndex());
+        resetGasBudget();
         break;
       case OpCode::Return_call:
         updateInstrCount();
@@ -789,6 +981,7 @@ public:
         updateInstrCount();
         updateGas();
         compileCallRefOp(Instr.getTargetIndex());
+        resetGasBudget();
         break;
       case OpCode::Return_call_ref:
         updateInstrCount();
@@ -874,14 +1067,21 @@ public:
       }
       case OpCode::Local__get: {
         const auto &L = Local[Instr.getTargetIndex()];
-        stackPush(Builder.createLoad(L.first, L.second));
+        auto Value = Builder.createLoad(L.first, L.second);
+        LocalValues.emplace(Value.unwrap(),
+                            LocalVersion[Instr.getTargetIndex()]);
+        stackPush(Value);
         break;
       }
       case OpCode::Local__set:
         Builder.createStore(stackPop(), Local[Instr.getTargetIndex()].second);
+        LocalVersion[Instr.getTargetIndex()] = NextLocalVersion++;
         break;
       case OpCode::Local__tee:
         Builder.createStore(Stack.back(), Local[Instr.getTargetIndex()].second);
+        LocalVersion[Instr.getTargetIndex()] = NextLocalVersion++;
+        LocalValues.try_emplace(Stack.back().unwrap(),
+                                LocalVersion[Instr.getTargetIndex()]);
         break;
       case OpCode::Global__get: {
         const auto G =
@@ -3048,29 +3248,80 @@ public:
       }
       return;
     };
-    for (const auto &Instr : Instrs) {
-      // Update instruction count
-      if (LocalInstrCount) {
-        Builder.createStore(
-            Builder.createAdd(
-                Builder.createLoad(Context.Int64Ty, LocalInstrCount),
-                LLContext.getInt64(1)),
-            LocalInstrCount);
-      }
-      if (LocalGas) {
-        auto NewGas = Builder.createAdd(
-            Builder.createLoad(Context.Int64Ty, LocalGas),
-            Builder.createLoad(
-                Context.Int64Ty,
-                Builder.createConstInBoundsGEP2_64(
-                    LLVM::Type::getArrayType(Context.Int64Ty, UINT16_MAX + 1),
-                    Context.getCostTable(Builder, ExecCtx), 0,
-                    uint16_t(Instr.getOpCode()))));
-        Builder.createStore(NewGas, LocalGas);
+    for (size_t I = 0; I < Instrs.size(); ++I) {
+      // Update instruction count and gas of the instructions till the next
+      // control instruction at once.
+      if ((I == 0 || isControlInstr(Instrs[I - 1])) && !isUnreachable()) {
+        countInstrs(Instrs.subspan(I));
+        if (I == 0) {
+          // Check the gas at the function entry.
+          checkGas();
+        }
       }
 
       // Make the instruction node according to Code.
-      Dispatch(Instr);
+      Dispatch(Instrs[I]);
+    }
+  }
+
+  /// Check the instruction changes the control flow, which ends the straight
+  /// line code of the instruction counting and the gas metering.
+  static bool isControlInstr(const AST::Instruction &Instr) noexcept {
+    switch (Instr.getOpCode()) {
+    case OpCode::Block:
+    case OpCode::Loop:
+    case OpCode::If:
+    case OpCode::Else:
+    case OpCode::End:
+    case OpCode::Unreachable:
+    case OpCode::Return:
+    case OpCode::Br:
+    case OpCode::Br_if:
+    case OpCode::Br_table:
+    case OpCode::Br_on_null:
+    case OpCode::Br_on_non_null:
+    case OpCode::Call:
+    case OpCode::Call_indirect:
+    case OpCode::Return_call:
+    case OpCode::Return_call_indirect:
+    case OpCode::Call_ref:
+    case OpCode::Return_call_ref:
+      return true;
+    default:
+      return false;
+    }
+  }
+
+  /// Add the instruction count and the costs of the straight line code at the
+  /// beginning of Instrs. The costs are summed up by the opcodes at compile
+  /// time.
+  void countInstrs(AST::InstrView Instrs) noexcept {
+    uint64_t Count = 0;
+    std::map<OpCode, uint64_t> OpCounts;
+    for (const auto &Instr : Instrs) {
+      ++Count;
+      ++OpCounts[Instr.getOpCode()];
+      if (isControlInstr(Instr)) {
+        break;
+      }
+    }
+    if (LocalInstrCount) {
+      Builder.createStore(
+          Builder.createAdd(
+              Builder.createLoad(Context.Int64Ty, LocalInstrCount),
+              LLContext.getInt64(Count)),
+          LocalInstrCount);
+    }
+    if (LocalGas) {
+      LLVM::Value Cost = LLContext.getInt64(0);
+      for (const auto &[Op, N] : OpCounts) {
+        Cost = Builder.createAdd(
+            Cost, Builder.createMul(OpCosts[Op], LLContext.getInt64(N)));
+      }
+      Builder.createStore(
+          Builder.createAdd(Builder.createLoad(Context.Int64Ty, LocalGas),
+                            Cost),
+          LocalGas);
     }
   }
   void compileSignedTrunc(LLVM::Type IntType) noexcept {
@@ -3300,7 +3551,7 @@ public:
     Builder.createFence(LLVMAtomicOrderingSequentiallyConsistent);
   }
   void compileAtomicNotify(unsigned MemoryIndex,
-                           unsigned MemoryOffset) noexcept {
+                           uint64_t MemoryOffset) noexcept {
     auto Count = stackPop();
     auto Addr = Builder.createZExt(Stack.back(), Context.Int64Ty);
     if (MemoryOffset != 0) {
@@ -3317,7 +3568,7 @@ public:
                 {Context.Int32Ty, Context.Int32Ty, Context.Int32Ty}, false)),
         {LLContext.getInt32(MemoryIndex), Offset, Count}));
   }
-  void compileAtomicWait(unsigned MemoryIndex, unsigned MemoryOffset,
+  void compileAtomicWait(unsigned MemoryIndex, uint64_t MemoryOffset,
                          LLVM::Type TargetType, uint32_t BitWidth) noexcept {
     auto Timeout = stackPop();
     auto ExpectedValue = Builder.createZExtOrTrunc(stackPop(), Context.Int64Ty);
@@ -3339,7 +3590,7 @@ public:
         {LLContext.getInt32(MemoryIndex), Offset, ExpectedValue, Timeout,
          LLContext.getInt32(BitWidth)}));
   }
-  void compileAtomicLoad(unsigned MemoryIndex, unsigned MemoryOffset,
+  void compileAtomicLoad(unsigned MemoryIndex, uint64_t MemoryOffset,
                          unsigned Alignment, LLVM::Type IntType,
                          LLVM::Type TargetType, bool Signed = false) noexcept {
 
@@ -3363,7 +3614,7 @@ public:
       Stack.back() = Builder.createZExt(Load, IntType);
     }
   }
-  void compileAtomicStore(unsigned MemoryIndex, unsigned MemoryOffset,
+  void compileAtomicStore(unsigned MemoryIndex, uint64_t MemoryOffset,
                           unsigned Alignment, LLVM::Type, LLVM::Type TargetType,
                           bool Signed = false) noexcept {
     auto V = stackPop();
@@ -3387,7 +3638,7 @@ public:
     Store.setOrdering(LLVMAtomicOrderingSequentiallyConsistent);
   }
 
-  void compileAtomicRMWOp(unsigned MemoryIndex, unsigned MemoryOffset,
+  void compileAtomicRMWOp(unsigned MemoryIndex, uint64_t MemoryOffset,
                           [[maybe_unused]] unsigned Alignment,
                           LLVMAtomicRMWBinOp BinOp, LLVM::Type IntType,
                           LLVM::Type TargetType, bool Signed = false) noexcept {
@@ -3413,7 +3664,7 @@ public:
       Stack.back() = Builder.createZExt(Ret, IntType);
     }
   }
-  void compileAtomicCompareExchange(unsigned MemoryIndex, unsigned MemoryOffset,
+  void compileAtomicCompareExchange(unsigned MemoryIndex, uint64_t MemoryOffset,
                                     [[maybe_unused]] unsigned Alignment,
                                     LLVM::Type IntType, LLVM::Type TargetType,
                                     bool Signed = false) noexcept {
@@ -3514,12 +3765,45 @@ public:
       Builder.positionAtEnd(EndBB);
 
       Builder.createStore(LLContext.getInt64(0), LocalGas);
+      Builder.createStore(Builder.createSub(GasLimit, NewGas), LocalGasBudget);
 
       PHIOldGas.addIncoming(Gas, CurrBB);
       PHIOldGas.addIncoming(RGas, OkBB);
     }
   }
 
+  /// Check the local gas is in the budget of the remaining gas, the deadline
+  /// derived at the last update, and update the shared gas with the limit
+  /// check only when exceeded.
+  void checkGas() noexcept {
+    if (LocalGas) {
+      auto UpdateBB = LLVM::BasicBlock::create(LLContext, F.Fn, "gas_update");
+      auto EndBB = LLVM::BasicBlock::create(LLContext, F.Fn, "gas_in_budget");
+      auto InBudget = Builder.createLikely(Builder.createICmpULE(
+          Builder.createLoad(Context.Int64Ty, LocalGas),
+          Builder.createLoad(Context.Int64Ty, LocalGasBudget)));
+      Builder.createCondBr(InBudget, EndBB, UpdateBB);
+      Builder.positionAtEnd(UpdateBB);
+      updateGas();
+      Builder.createBr(EndBB);
+      Builder.positionAtEnd(EndBB);
+    }
+  }
+
+  /// Derive the budget from the shared gas, which is consumed by the other
+  /// functions.
+  void resetGasBudget() noexcept {
+    if (LocalGas) {
+      auto Gas = Builder.createLoad(Context.Int64Ty,
+                                    Context.getGas(Builder, ExecCtx));
+      Gas.setAlignment(8);
+      Gas.setOrdering(LLVMAtomicOrderingMonotonic);
+      Builder.createStore(
+          Builder.createSub(Context.getGasLimit(Builder, ExecCtx), Gas),
+          LocalGasBudget);
+    }
+  }
+
   void updateGasAtTrap() noexcept {
     if (LocalGas) {
       auto Update [[maybe_unused]] = Builder.createAtomicRMW(
@@ -3536,7 +3820,7 @@ private:
   void compileCallOp(const unsigned int FuncIndex) noexcept {
     const auto &FuncType =
         *Context.FunctionTypes[std::get<0>(Context.Functions[FuncIndex])];
-    const auto &Function = std::get<1>(Context.Functions[FuncIndex]);
+    const auto Function = Context.getFunction(FuncIndex);
     const auto &ParamTypes = FuncType.getParamTypes();
 
     std::vector<LLVM::Value> Args(ParamTypes.size() + 1);
@@ -3683,7 +3967,7 @@ private:
   void compileReturnCallOp(const unsigned int FuncIndex) noexcept {
     const auto &FuncType =
         *Context.FunctionTypes[std::get<0>(Context.Functions[FuncIndex])];
-    const auto &Function = std::get<1>(Context.Functions[FuncIndex]);
+    const auto Function = Context.getFunction(FuncIndex);
     const auto &ParamTypes = FuncType.getParamTypes();
 
     std::vector<LLVM::Value> Args(ParamTypes.size() + 1);
@@ -4039,12 +4323,14 @@ private:
     }
   }
 
-  void compileLoadOp(unsigned MemoryIndex, unsigned Offset, unsigned Alignment,
+  void compileLoadOp(unsigned MemoryIndex, uint64_t Offset, unsigned Alignment,
                      LLVM::Type LoadTy) noexcept {
     if constexpr (kForceUnalignment) {
       Alignment = 0;
     }
-    auto Off = Builder.createZExt(stackPop(), Context.Int64Ty);
+    auto Base = stackPop();
+    const bool InBounds = isInBounds(MemoryIndex, Base, Offset, LoadTy);
+    auto Off = Builder.createZExt(Base, Context.Int64Ty);
     if (Offset != 0) {
       Off = Builder.createAdd(Off, LLContext.getInt64(Offset));
     }
@@ -4052,11 +4338,11 @@ private:
     auto VPtr = Builder.createInBoundsGEP1(
         Context.Int8Ty, Context.getMemory(Builder, ExecCtx, MemoryIndex), Off);
     auto Ptr = Builder.createBitCast(VPtr, LoadTy.getPointerTo());
-    auto LoadInst = Builder.createLoad(LoadTy, Ptr, true);
+    auto LoadInst = Builder.createLoad(LoadTy, Ptr, !InBounds);
     LoadInst.setAlignment(1 << Alignment);
     stackPush(LoadInst);
   }
-  void compileLoadOp(unsigned MemoryIndex, unsigned Offset, unsigned Alignment,
+  void compileLoadOp(unsigned MemoryIndex, uint64_t Offset, unsigned Alignment,
                      LLVM::Type LoadTy, LLVM::Type ExtendTy,
                      bool Signed) noexcept {
     compileLoadOp(MemoryIndex, Offset, Alignment, LoadTy);
@@ -4066,24 +4352,24 @@ private:
       Stack.back() = Builder.createZExt(Stack.back(), ExtendTy);
     }
   }
-  void compileVectorLoadOp(unsigned MemoryIndex, unsigned Offset,
+  void compileVectorLoadOp(unsigned MemoryIndex, uint64_t Offset,
                            unsigned Alignment, LLVM::Type LoadTy) noexcept {
     compileLoadOp(MemoryIndex, Offset, Alignment, LoadTy);
     Stack.back() = Builder.createBitCast(Stack.back(), Context.Int64x2Ty);
   }
-  void compileVectorLoadOp(unsigned MemoryIndex, unsigned Offset,
+  void compileVectorLoadOp(unsigned MemoryIndex, uint64_t Offset,
                            unsigned Alignment, LLVM::Type LoadTy,
                            LLVM::Type ExtendTy, bool Signed) noexcept {
     compileLoadOp(MemoryIndex, Offset, Alignment, LoadTy, ExtendTy, Signed);
     Stack.back() = Builder.createBitCast(Stack.back(), Context.Int64x2Ty);
   }
-  void compileSplatLoadOp(unsigned MemoryIndex, unsigned Offset,
+  void compileSplatLoadOp(unsigned MemoryIndex, uint64_t Offset,
                           unsigned Alignment, LLVM::Type LoadTy,
                           LLVM::Type VectorTy) noexcept {
     compileLoadOp(MemoryIndex, Offset, Alignment, LoadTy);
     compileSplatOp(VectorTy);
   }
-  void compileLoadLaneOp(unsigned MemoryIndex, unsigned Offset,
+  void compileLoadLaneOp(unsigned MemoryIndex, uint64_t Offset,
                          unsigned Alignment, unsigned Index, LLVM::Type LoadTy,
                          LLVM::Type VectorTy) noexcept {
     auto Vector = stackPop();
@@ -4094,7 +4380,7 @@ private:
                                     Value, LLContext.getInt64(Index)),
         Context.Int64x2Ty);
   }
-  void compileStoreLaneOp(unsigned MemoryIndex, unsigned Offset,
+  void compileStoreLaneOp(unsigned MemoryIndex, uint64_t Offset,
                           unsigned Alignment, unsigned Index, LLVM::Type LoadTy,
                           LLVM::Type VectorTy) noexcept {
     auto Vector = Stack.back();
@@ -4102,14 +4388,16 @@ private:
         Builder.createBitCast(Vector, VectorTy), LLContext.getInt64(Index));
     compileStoreOp(MemoryIndex, Offset, Alignment, LoadTy);
   }
-  void compileStoreOp(unsigned MemoryIndex, unsigned Offset, unsigned Alignment,
+  void compileStoreOp(unsigned MemoryIndex, uint64_t Offset, unsigned Alignment,
                       LLVM::Type LoadTy, bool Trunc = false,
                       bool BitCast = false) noexcept {
     if constexpr (kForceUnalignment) {
       Alignment = 0;
     }
     auto V = stackPop();
-    auto Off = Builder.createZExt(stackPop(), Context.Int64Ty);
+    auto Base = stackPop();
+    const bool InBounds = isInBounds(MemoryIndex, Base, Offset, LoadTy);
+    auto Off = Builder.createZExt(Base, Context.Int64Ty);
     if (Offset != 0) {
       Off = Builder.createAdd(Off, LLContext.getInt64(Offset));
     }
@@ -4123,7 +4411,7 @@ private:
     auto VPtr = Builder.createInBoundsGEP1(
         Context.Int8Ty, Context.getMemory(Builder, ExecCtx, MemoryIndex), Off);
     auto Ptr = Builder.createBitCast(VPtr, LoadTy.getPointerTo());
-    auto StoreInst = Builder.createStore(V, Ptr, true);
+    auto StoreInst = Builder.createStore(V, Ptr, !InBounds);
     StoreInst.setAlignment(1 << Alignment);
   }
   void compileSplatOp(LLVM::Type VectorTy) noexcept {
@@ -5022,25 +5310,88 @@ private:
     return Entry;
   }
 
+  /// Check the interruption at the function entries and the loop headers by
+  /// comparing the epoch with the deadline. Only plain loads are needed.
   void checkStop() noexcept {
     if (!Interruptible) {
       return;
     }
     auto NotStopBB = LLVM::BasicBlock::create(LLContext, F.Fn, "NotStop");
-    auto StopToken = Builder.createAtomicRMW(
-        LLVMAtomicRMWBinOpXchg, Context.getStopToken(Builder, ExecCtx),
-        LLContext.getInt32(0), LLVMAtomicOrderingMonotonic);
-#if LLVM_VERSION_MAJOR >= 13
-    StopToken.setAlignment(32);
-#endif
-    auto NotStop = Builder.createLikely(
-        Builder.createICmpEQ(StopToken, LLContext.getInt32(0)));
+    auto Epoch = Builder.createLoad(Context.Int64Ty,
+                                    Context.getEpoch(Builder, ExecCtx));
+    Epoch.setAlignment(8);
+    Epoch.setOrdering(LLVMAtomicOrderingMonotonic);
+    auto Deadline = Builder.createLoad(Context.Int64Ty,
+                                       Context.getDeadline(Builder, ExecCtx));
+    Deadline.setAlignment(8);
+    Deadline.setOrdering(LLVMAtomicOrderingMonotonic);
+    auto NotStop = Builder.createLikely(Builder.createICmpULT(Epoch, Deadline));
     Builder.createCondBr(NotStop, NotStopBB,
                          getTrapBB(ErrCode::Value::Interrupted));
 
     Builder.positionAtEnd(NotStopBB);
   }
 
+  /// Set the branch weights of the conditional branch from the counts of the
+  /// `if` or `br_if` instruction at Offset in the profile.
+  void setBranchWeights(LLVM::Value Br, uint32_t Offset) noexcept {
+    if (!Context.Prof) {
+      return;
+    }
+    const auto *Count = Context.Prof->getBranchCount(Offset);
+    if (!Count || (Count->Taken == 0 && Count->NotTaken == 0)) {
+      return;
+    }
+    // The weights are 32-bit. Scale the counts down as the same as LLVM.
+    const uint64_t Scale =
+        std::max(Count->Taken, Count->NotTaken) /
+            std::numeric_limits<uint32_t>::max() +
+        1;
+    std::array<LLVM::Metadata, 3> Weights = {
+        LLVM::Metadata::getString(LLContext, "branch_weights"sv),
+        LLVM::Metadata(LLContext.getInt32(
+            static_cast<uint32_t>(Count->Taken / Scale))),
+        LLVM::Metadata(LLContext.getInt32(
+            static_cast<uint32_t>(Count->NotTaken / Scale)))};
+    Br.setMetadata(LLContext, LLVM::Core::Prof,
+                   LLVM::Metadata(LLContext, Weights));
+  }
+
+  /// Check the access of the type at the address Base + Offset is proven in
+  /// bounds, by the minimum memory size or by the dominating accesses from the
+  /// same value. The other accesses stay volatile to trap in order on the
+  /// guard region, and prove the range for the later ones.
+  bool isInBounds(unsigned MemoryIndex, LLVM::Value Base, uint64_t Offset,
+                  LLVM::Type Ty) noexcept {
+    ++Context.MemoryAccessCount;
+    const uint64_t End = Offset + Ty.getPrimitiveSizeInBits() / 8;
+    if (Base.isAConstantInt()) {
+      if (MemoryIndex < Context.MemoryMinSizes.size() &&
+          Base.getZExtValue() + End <= Context.MemoryMinSizes[MemoryIndex]) {
+        ++Context.InBoundsAccessCount;
+        return true;
+      }
+      return false;
+    }
+    const auto It = LocalValues.find(Base.unwrap());
+    if (It == LocalValues.end()) {
+      return false;
+    }
+    const uint64_t Key =
+        (static_cast<uint64_t>(It->second) << 32) | MemoryIndex;
+    // The ranges proven in the enclosing blocks dominate this access.
+    for (auto C = ControlStack.rbegin(); C != ControlStack.rend(); ++C) {
+      if (auto Range = C->ProvenRanges.find(Key);
+          Range != C->ProvenRanges.end() && End <= Range->second) {
+        ++Context.InBoundsAccessCount;
+        return true;
+      }
+    }
+    auto &Range = ControlStack.back().ProvenRanges[Key];
+    Range = std::max(Range, End);
+    return false;
+  }
+
   void setUnreachable() noexcept {
     if (ControlStack.empty()) {
       IsUnreachable = true;
@@ -5133,9 +5484,19 @@ private:
   LLVM::Compiler::CompileContext &Context;
   LLVM::Context LLContext;
   std::vector<std::pair<LLVM::Type, LLVM::Value>> Local;
+  /// Versions of the locals, renewed on the writes. The values read from the
+  /// same version are the same.
+  std::vector<uint32_t> LocalVersion;
+  uint32_t NextLocalVersion = 0;
+  /// Local versions of the values read by `local.get` and `local.tee`.
+  std::unordered_map<LLVMValueRef, uint32_t> LocalValues;
   std::vector<LLVM::Value> Stack;
   LLVM::Value LocalInstrCount = nullptr;
   LLVM::Value LocalGas = nullptr;
+  /// Remaining gas at the last update of the shared gas.
+  LLVM::Value LocalGasBudget = nullptr;
+  /// Costs of the opcodes in the function, loaded at the entry.
+  std::unordered_map<OpCode, LLVM::Value> OpCosts;
   std::unordered_map<ErrCode::Value, LLVM::BasicBlock> TrapBB;
   bool IsUnreachable = false;
   bool Interruptible = false;
@@ -5149,6 +5510,9 @@ private:
     std::pair<std::vector<ValType>, std::vector<ValType>> Type;
     std::vector<std::tuple<std::vector<LLVM::Value>, LLVM::BasicBlock>>
         ReturnPHI;
+    /// End offsets of the accesses from the local values in this block, keyed
+    /// by the local version and the memory index.
+    std::unordered_map<uint64_t, uint64_t> ProvenRanges;
     Control(size_t S, bool U, LLVM::BasicBlock J, LLVM::BasicBlock N,
             LLVM::BasicBlock E, std::vector<LLVM::Value> A,
             std::pair<std::vector<ValType>, std::vector<ValType>> T,
@@ -5184,26 +5548,299 @@ std::vector<LLVM::Value> unpackStruct(LLVM::Builder &Builder,
 namespace WasmEdge {
 namespace LLVM {
 
-Expect<Data> Compiler::compile(const AST::Module &Module) noexcept {
+namespace {
+
+/// Create the summary of the profile for the module flag, which enables the
+/// profile-guided passes to classify the hot and cold code.
+LLVM::Metadata createProfileSummary(LLVM::Context LLContext,
+                                    const Profile &Prof) noexcept {
+  std::vector<uint64_t> Counts;
+  for (const auto &[Index, Count] : Prof.getFunctions()) {
+    Counts.push_back(Count);
+  }
+  for (const auto &[Offset, Count] : Prof.getBranches()) {
+    Counts.push_back(Count.Taken);
+    Counts.push_back(Count.NotTaken);
+  }
+  std::sort(Counts.begin(), Counts.end(), std::greater<>());
+  const uint64_t Total = std::accumulate(Counts.begin(), Counts.end(),
+                                         static_cast<uint64_t>(0));
+  uint64_t MaxFunctionCount = 0;
+  for (const auto &[Index, Count] : Prof.getFunctions()) {
+    MaxFunctionCount = std::max(MaxFunctionCount, Count);
+  }
+
+  auto Entry = [&LLContext](std::string_view Key, uint64_t Val) {
+    std::array<LLVM::Metadata, 2> Pair = {
+        LLVM::Metadata::getString(LLContext, Key),
+        LLVM::Metadata(LLContext.getInt64(Val))};
+    return LLVM::Metadata(LLContext, Pair);
+  };
+
+  // The minimum count of the hottest counters, which sum up to the cutoffs of
+  // the total count in the millionths.
+  constexpr std::array<uint32_t, 16> Cutoffs = {
+      10000,  100000, 200000, 300000, 400000, 500000, 600000, 700000,
+      800000, 900000, 950000, 990000, 999000, 999900, 999990, 999999};
+  std::vector<LLVM::Metadata> Details;
+  size_t I = 0;
+  uint64_t Sum = 0;
+  for (const auto Cutoff : Cutoffs) {
+    const uint64_t Desired =
+        Total / 1000000 * Cutoff + Total % 1000000 * Cutoff / 1000000;
+    while (I < Counts.size() && Sum < Desired) {
+      Sum += Counts[I++];
+    }
+    std::array<LLVM::Metadata, 3> Detail = {
+        LLVM::Metadata(LLContext.getInt32(Cutoff)),
+        LLVM::Metadata(LLContext.getInt64(I > 0 ? Counts[I - 1] : 0)),
+        LLVM::Metadata(LLContext.getInt32(static_cast<uint32_t>(I)))};
+    Details.emplace_back(LLContext, Detail);
+  }
+  std::array<LLVM::Metadata, 2> DetailedSummary = {
+      LLVM::Metadata::getString(LLContext, "DetailedSummary"sv),
+      LLVM::Metadata(LLContext, Details)};
+
+  std::array<LLVM::Metadata, 2> ProfileFormat = {
+      LLVM::Metadata::getString(LLContext, "ProfileFormat"sv),
+      LLVM::Metadata::getString(LLContext, "InstrProf"sv)};
+
+  std::array<LLVM::Metadata, 8> Summary = {
+      LLVM::Metadata(LLContext, ProfileFormat),
+      Entry("TotalCount"sv, Total),
+      Entry("MaxCount"sv, Counts.empty() ? 0 : Counts.front()),
+      Entry("MaxInternalCount"sv, Counts.empty() ? 0 : Counts.front()),
+      Entry("MaxFunctionCount"sv, MaxFunctionCount),
+      Entry("NumCounts"sv, Counts.size()),
+      Entry("NumFunctions"sv, Prof.getFunctions().size()),
+      LLVM::Metadata(LLContext, DetailedSummary)};
+  return LLVM::Metadata(LLContext, Summary);
+}
+
+/// Check the module is supported by the compiler.
+Expect<void> checkModule(const AST::Module &Module) noexcept {
   // Check the module is validated.
   if (unlikely(!Module.getIsValidated())) {
     spdlog::error(ErrCode::Value::NotValidated);
     return Unexpect(ErrCode::Value::NotValidated);
   }
 
+  // The compiled code relies on the guard region of the 32-bit addresses. The
+  // modules with the 64-bit memories are left to the interpreter.
+  const auto &MemTypes = Module.getMemorySection().getContent();
+  const auto &Imports = Module.getImportSection().getContent();
+  if (std::any_of(MemTypes.begin(), MemTypes.end(),
+                  [](const AST::MemoryType &MemType) {
+                    return MemType.getLimit().is64();
+                  }) ||
+      std::any_of(Imports.begin(), Imports.end(),
+                  [](const AST::ImportDesc &ImpDesc) {
+                    return ImpDesc.getExternalType() ==
+                               ExternalType::Memory &&
+                           ImpDesc.getExternalMemoryType().getLimit().is64();
+                  })) {
+    spdlog::error(ErrCode::Value::CompileNotSupported);
+    spdlog::error("    64-bit memories are not supported in AOT."sv);
+    return Unexpect(ErrCode::Value::CompileNotSupported);
+  }
+  return {};
+}
+
+} // namespace
+
+std::string Compiler::getCacheKey() const {
+  const auto &CompilerConf = Conf.getCompilerConfigure();
+  const auto &StatConf = Conf.getStatisticsConfigure();
+  std::string Proposals;
+  for (uint8_t I = 0; I < static_cast<uint8_t>(Proposal::Max); ++I) {
+    Proposals.push_back(Conf.hasProposal(static_cast<Proposal>(I)) ? '1'
+                                                                   : '0');
+  }
+  return fmt::format(
+      "{} {} {} {} {} O{} g{} f{} i{} c{} m{} t{} p{}"sv, kVersionString,
+      AOT::kBinaryVersion, LLVM::getDefaultTargetTriple().string_view(),
+      LLVM::getHostCPUName().string_view(),
+      LLVM::getHostCPUFeatures().string_view(),
+      static_cast<uint32_t>(CompilerConf.getOptimizationLevel()),
+      CompilerConf.isGenericBinary(), CompilerConf.isFatBinary(),
+      CompilerConf.isInterruptible(),
+      StatConf.isInstructionCounting(), StatConf.isCostMeasuring(),
+      StatConf.isTimeMeasuring(), Proposals);
+}
+
+Expect<Data> Compiler::compile(const AST::Module &Module) noexcept {
+  if (auto Res = checkModule(Module); unlikely(!Res)) {
+    return Unexpect(Res);
+  }
+
   std::unique_lock Lock(Mutex);
   spdlog::info("compile start");
 
   LLVM::Core::init();
 
+  if (!Conf.getCompilerConfigure().isFatBinary()) {
+    return compileTarget(Module, Target);
+  }
+  if (Conf.getCompilerConfigure().getOutputFormat() !=
+      CompilerConfigure::OutputFormat::Wasm) {
+    spdlog::warn("fat binary is only for the universal WASM format, compile "
+                 "for the single target instead."sv);
+    return compileTarget(Module, Target);
+  }
+
+  // The variants are compiled in the ascending order, and held by the first
+  // one.
+  std::optional<Data> D;
+  for (const auto Level : AOT::kFatTargetLevels) {
+    spdlog::info("compile for target {}"sv, AOT::getTargetCPUName(Level));
+    auto Res = compileTarget(Module, Level);
+    if (unlikely(!Res)) {
+      return Unexpect(Res);
+    }
+    if (!D) {
+      D.emplace(std::move(*Res));
+    } else {
+      D->extract().Variants.push_back(std::move(*Res));
+    }
+  }
+  return Expect<Data>{std::move(*D)};
+}
+
+Expect<Data> Compiler::compileTarget(const AST::Module &Module,
+                                     AOT::TargetLevel Level) noexcept {
+  // Split the defined functions into the contiguous partitions by the code
+  // size. The partitions only depend on the module, so the output is the same
+  // for any worker thread number.
+  const auto &CodeSegs = Module.getCodeSection().getContent();
+  std::vector<size_t> Bounds = {0};
+  {
+    uint64_t Total = 0;
+    for (const auto &Code : CodeSegs) {
+      Total += Code.getSegSize();
+    }
+    const uint64_t Target =
+        std::max(kPartitionCodeSize, Total / kMaxPartitions + 1);
+    uint64_t Size = 0;
+    for (size_t I = 0; I + 1 < CodeSegs.size(); ++I) {
+      Size += CodeSegs[I].getSegSize();
+      if (Size >= Target) {
+        Bounds.push_back(I + 1);
+        Size = 0;
+      }
+    }
+    Bounds.push_back(CodeSegs.size());
+  }
+  const size_t PartitionNum = Bounds.size() - 1;
+
+  uint32_t ThreadNum = Conf.getCompilerConfigure().getCompileThreadNum();
+  if (ThreadNum == 0) {
+    ThreadNum = std::max(std::thread::hardware_concurrency(), 1U);
+  }
+  const auto WorkerNum =
+      static_cast<uint32_t>(std::min<size_t>(ThreadNum, PartitionNum) - 1);
+  if (PartitionNum > 1) {
+    spdlog::info("compile {} partitions with {} threads"sv, PartitionNum,
+                 WorkerNum + 1);
+  }
+
+  // The partition 0 is compiled in the current thread, and the others are
+  // compiled by the workers. Each partition has its own compiler and context.
+  std::vector<std::optional<Expect<Data>>> Results(PartitionNum);
+  auto CompilePart = [&](size_t I) noexcept {
+    Compiler Worker(Conf);
+    Worker.Target = Level;
+    Worker.Prof = Prof;
+    Results[I].emplace(Worker.compilePartition(
+        Module, static_cast<uint32_t>(I), Bounds[I], Bounds[I + 1]));
+  };
+  {
+    std::optional<ThreadPool> Pool;
+    if (WorkerNum > 0) {
+      Pool.emplace(WorkerNum);
+      for (size_t I = 1; I < PartitionNum; ++I) {
+        Pool->submit([&CompilePart, I]() { CompilePart(I); });
+      }
+    }
+    CompilePart(0);
+    if (!Pool) {
+      for (size_t I = 1; I < PartitionNum; ++I) {
+        CompilePart(I);
+      }
+    }
+  }
+
+  for (auto &Res : Results) {
+    if (unlikely(!*Res)) {
+      return Unexpect(*Res);
+    }
+  }
+  Data D = std::move(**Results[0]);
+  D.extract().Partitions.reserve(PartitionNum - 1);
+  for (size_t I = 1; I < PartitionNum; ++I) {
+    D.extract().Partitions.push_back(std::move(**Results[I]));
+  }
+
+  spdlog::info("optimize done");
+  return Expect<Data>{std::move(D)};
+}
+
+Expect<Data> Compiler::compileFunction(const AST::Module &Module,
+                                       uint32_t Index) noexcept {
+  if (auto Res = checkModule(Module); unlikely(!Res)) {
+    return Unexpect(Res);
+  }
+  if (unlikely(Index >= Module.getCodeSection().getContent().size())) {
+    spdlog::error(ErrCode::Value::FuncNotFound);
+    return Unexpect(ErrCode::Value::FuncNotFound);
+  }
+
+  std::unique_lock Lock(Mutex);
+  LLVM::Core::init();
+  // Compiled as the main partition for the type wrappers and the intrinsics
+  // table.
+  return compilePartition(Module, 0, Index, Index + 1, true);
+}
+
+Expect<Data> Compiler::compileLazy(const AST::Module &Module) noexcept {
+  if (auto Res = checkModule(Module); unlikely(!Res)) {
+    return Unexpect(Res);
+  }
+
+  std::unique_lock Lock(Mutex);
+  LLVM::Core::init();
+  return compilePartition(Module, 0, 0, 0);
+}
+
+Expect<Data> Compiler::compileLazyFunction(const AST::Module &Module,
+                                           uint32_t Index) noexcept {
+  if (unlikely(Index >= Module.getCodeSection().getContent().size())) {
+    spdlog::error(ErrCode::Value::FuncNotFound);
+    return Unexpect(ErrCode::Value::FuncNotFound);
+  }
+
+  std::unique_lock Lock(Mutex);
+  return compilePartition(Module, Index + 1, Index, Index + 1);
+}
+
+Expect<Data> Compiler::compilePartition(const AST::Module &Module,
+                                        uint32_t Index, size_t Begin,
+                                        size_t End,
+                                        bool IsStandalone) noexcept {
   LLVM::Data D;
   auto LLContext = D.extract().LLContext();
   auto &LLModule = D.extract().LLModule;
   LLModule.setTarget(LLVM::getDefaultTargetTriple().unwrap());
   LLModule.addFlag(LLVMModuleFlagBehaviorError, "PIC Level"sv, 2);
 
-  CompileContext NewContext(LLContext, LLModule,
-                            Conf.getCompilerConfigure().isGenericBinary());
+  CompileContext NewContext(LLContext, LLModule, Target, Index == 0);
+  NewContext.IsStandalone = IsStandalone;
+  NewContext.FuncBegin = Begin;
+  NewContext.FuncEnd = End;
+  if (Prof) {
+    NewContext.Prof = &*Prof;
+    LLModule.addFlag(LLVMModuleFlagBehaviorError, "ProfileSummary"sv,
+                     createProfileSummary(LLContext, *Prof));
+  }
   struct RAIICleanup {
     RAIICleanup(CompileContext *&Context, CompileContext &NewContext)
         : Context(Context) {
@@ -5226,15 +5863,17 @@ Expect<Data> Compiler::compile(const AST::Module &Module) noexcept {
   compile(Module.getTableSection(), Module.getElementSection());
   // compile Functions in module. (FunctionSec, CodeSec)
   compile(Module.getFunctionSection(), Module.getCodeSection());
+  spdlog::debug("partition {}: {} of {} memory accesses proven in bounds"sv,
+                Index, NewContext.InBoundsAccessCount,
+                NewContext.MemoryAccessCount);
   // Compile ExportSection
   compile(Module.getExportSection());
   // StartSection is not required to compile
 
-  spdlog::info("verify start");
   LLModule.verify(LLVMPrintMessageAction);
 
-  spdlog::info("optimize start");
   auto &TM = D.extract().TM;
+  D.extract().Target = Target;
   {
     auto Triple = LLModule.getTarget();
     auto [TheTarget, ErrorMessage] = LLVM::Target::getFromTriple(Triple);
@@ -5243,19 +5882,23 @@ Expect<Data> Compiler::compile(const AST::Module &Module) noexcept {
       return Unexpect(ErrCode::Value::IllegalPath);
     } else {
       std::string CPUName;
+      // The features of the other levels are implied by the CPU names.
+      LLVM::Message Features;
 #if defined(__riscv) && __riscv_xlen == 64
       CPUName = "generic-rv64"s;
+      Features = LLVM::getHostCPUFeatures();
 #else
-      if (!Conf.getCompilerConfigure().isGenericBinary()) {
+      if (Target == AOT::TargetLevel::Host) {
         CPUName = LLVM::getHostCPUName().string_view();
+        Features = LLVM::getHostCPUFeatures();
       } else {
-        CPUName = "generic"s;
+        CPUName = AOT::getTargetCPUName(Target);
       }
 #endif
 
       TM = LLVM::TargetMachine::create(
           TheTarget, Triple, CPUName.c_str(),
-          LLVM::getHostCPUFeatures().unwrap(),
+          Features ? Features.unwrap() : "",
           toLLVMCodeGenLevel(
               Conf.getCompilerConfigure().getOptimizationLevel()),
           LLVMRelocPIC, LLVMCodeModelDefault);
@@ -5304,10 +5947,12 @@ Expect<Data> Compiler::compile(const AST::Module &Module) noexcept {
 
   // Set initializer for constant value
   if (auto IntrinsicsTable = LLModule.getNamedGlobal("intrinsics")) {
-    IntrinsicsTable.setInitializer(
-        LLVM::Value::getConstNull(IntrinsicsTable.getType()));
+    if (Index == 0) {
+      IntrinsicsTable.setInitializer(
+          LLVM::Value::getConstNull(IntrinsicsTable.getType()));
+    }
     IntrinsicsTable.setGlobalConstant(false);
-  } else {
+  } else if (Index == 0) {
     auto IntrinsicsTableTy = LLVM::Type::getArrayType(
         LLContext.getInt8Ty().getPointerTo(),
         static_cast<uint32_t>(Executable::Intrinsics::kIntrinsicMax));
@@ -5316,7 +5961,6 @@ Expect<Data> Compiler::compile(const AST::Module &Module) noexcept {
         LLVM::Value::getConstNull(IntrinsicsTableTy), "intrinsics");
   }
 
-  spdlog::info("optimize done");
   return Expect<Data>{std::move(D)};
 }
 
@@ -5338,6 +5982,12 @@ void Compiler::compile(const AST::TypeSection &TypeSec) noexcept {
   for (size_t I = 0; I < Size; ++I) {
     if (SubTypes[I].getCompositeType().isFunc()) {
       const auto &FuncType = SubTypes[I].getCompositeType().getFuncType();
+      if (!Context->IsMainPartition) {
+        // The wrappers are only in the main partition.
+        Context->FunctionTypes.push_back(&FuncType);
+        Context->FunctionWrappers.push_back(LLVM::Value());
+        continue;
+      }
       const auto Name = fmt::format("t{}"sv, Context->FunctionTypes.size());
 
       // Check function type is unique
@@ -5457,87 +6107,10 @@ void Compiler::compile(const AST::ImportSection &ImportSec) noexcept {
       // Get the function type index in module.
       uint32_t TypeIdx = ImpDesc.getExternalFuncTypeIdx();
       assuming(TypeIdx < Context->FunctionTypes.size());
-      const auto &FuncType = *Context->FunctionTypes[TypeIdx];
-      auto FTy =
-          toLLVMType(Context->LLContext, Context->ExecCtxPtrTy, FuncType);
-      auto RTy = FTy.getReturnType();
-      auto F = LLVM::FunctionCallee{
-          FTy,
-          Context->LLModule.addFunction(FTy, LLVMInternalLinkage,
-                                        fmt::format("f{}"sv, FuncID).c_str())};
-      F.Fn.setDSOLocal(true);
-      F.Fn.addFnAttr(Context->NoStackArgProbe);
-      F.Fn.addFnAttr(Context->StrictFP);
-      F.Fn.addFnAttr(Context->UWTable);
-      F.Fn.addParamAttr(0, Context->ReadOnly);
-      F.Fn.addParamAttr(0, Context->NoAlias);
-
-      LLVM::Builder Builder(Context->LLContext);
-      Builder.positionAtEnd(
-          LLVM::BasicBlock::create(Context->LLContext, F.Fn, "entry"));
-
-      const auto ArgSize = FuncType.getParamTypes().size();
-      const auto RetSize =
-          RTy.isVoidTy() ? 0 : FuncType.getReturnTypes().size();
-
-      LLVM::Value Args;
-      if (ArgSize == 0) {
-        Args = LLVM::Value::getConstNull(Context->Int8PtrTy);
-      } else {
-        auto Alloca = Builder.createArrayAlloca(
-            Context->Int8Ty, Context->LLContext.getInt64(ArgSize * kValSize));
-        Alloca.setAlignment(kValSize);
-        Args = Alloca;
-      }
-
-      LLVM::Value Rets;
-      if (RetSize == 0) {
-        Rets = LLVM::Value::getConstNull(Context->Int8PtrTy);
-      } else {
-        auto Alloca = Builder.createArrayAlloca(
-            Context->Int8Ty, Context->LLContext.getInt64(RetSize * kValSize));
-        Alloca.setAlignment(kValSize);
-        Rets = Alloca;
-      }
-
-      auto Arg = F.Fn.getFirstParam();
-      for (unsigned I = 0; I < ArgSize; ++I) {
-        Arg = Arg.getNextParam();
-        LLVM::Value Ptr = Builder.createConstInBoundsGEP1_64(
-            Context->Int8Ty, Args, I * kValSize);
-        Builder.createStore(
-            Arg, Builder.createBitCast(Ptr, Arg.getType().getPointerTo()));
-      }
-
-      Builder.createCall(
-          Context->getIntrinsic(
-              Builder, Executable::Intrinsics::kCall,
-              LLVM::Type::getFunctionType(
-                  Context->VoidTy,
-                  {Context->Int32Ty, Context->Int8PtrTy, Context->Int8PtrTy},
-                  false)),
-          {Context->LLContext.getInt32(FuncID), Args, Rets});
-
-      if (RetSize == 0) {
-        Builder.createRetVoid();
-      } else if (RetSize == 1) {
-        LLVM::Value VPtr =
-            Builder.createConstInBoundsGEP1_64(Context->Int8Ty, Rets, 0);
-        LLVM::Value Ptr = Builder.createBitCast(VPtr, RTy.getPointerTo());
-        Builder.createRet(Builder.createLoad(RTy, Ptr));
-      } else {
-        std::vector<LLVM::Value> Ret;
-        Ret.reserve(RetSize);
-        for (unsigned I = 0; I < RetSize; ++I) {
-          LLVM::Value VPtr = Builder.createConstInBoundsGEP1_64(
-              Context->Int8Ty, Rets, I * kValSize);
-          LLVM::Value Ptr = Builder.createBitCast(
-              VPtr, RTy.getStructElementType(I).getPointerTo());
-          Ret.push_back(Builder.createLoad(RTy.getStructElementType(I), Ptr));
-        }
-        Builder.createAggregateRet(Ret);
-      }
-
+      auto F = Context->createCallThunk(FuncID, TypeIdx,
+                                        Context->IsMainPartition
+                                            ? LLVMInternalLinkage
+                                            : LLVMPrivateLinkage);
       Context->Functions.emplace_back(TypeIdx, F, nullptr);
       break;
     }
@@ -5548,7 +6121,9 @@ void Compiler::compile(const AST::ImportSection &ImportSec) noexcept {
     }
     case ExternalType::Memory: // Memory type
     {
-      // Nothing to do.
+      const auto &MemType = ImpDesc.getExternalMemoryType();
+      Context->MemoryMinSizes.push_back(MemType.getLimit().getMin() *
+                                        kPageSize);
       break;
     }
     case ExternalType::Global: // Global type
@@ -5576,8 +6151,12 @@ void Compiler::compile(const AST::GlobalSection &GlobalSec) noexcept {
   }
 }
 
-void Compiler::compile(const AST::MemorySection &,
-                       const AST::DataSection &) noexcept {}
+void Compiler::compile(const AST::MemorySection &MemorySec,
+                       const AST::DataSection &) noexcept {
+  for (const auto &MemType : MemorySec.getContent()) {
+    Context->MemoryMinSizes.push_back(MemType.getLimit().getMin() * kPageSize);
+  }
+}
 
 void Compiler::compile(const AST::TableSection &,
                        const AST::ElementSection &) noexcept {}
@@ -5594,6 +6173,12 @@ void Compiler::compile(const AST::FunctionSection &FuncSec,
     const auto &TypeIdx = TypeIdxs[I];
     const auto &Code = CodeSegs[I];
     assuming(TypeIdx < Context->FunctionTypes.size());
+    if (I < Context->FuncBegin || I >= Context->FuncEnd) {
+      // Not in this partition. Declared on the first use.
+      Context->Functions.emplace_back(TypeIdx, LLVM::FunctionCallee(),
+                                      nullptr);
+      continue;
+    }
     const auto &FuncType = *Context->FunctionTypes[TypeIdx];
     const auto FuncID = Context->Functions.size();
     auto FTy = toLLVMType(Context->LLContext, Context->ExecCtxPtrTy, FuncType);
@@ -5608,6 +6193,20 @@ void Compiler::compile(const AST::FunctionSection &FuncSec,
     F.Fn.addFnAttr(Context->UWTable);
     F.Fn.addParamAttr(0, Context->ReadOnly);
     F.Fn.addParamAttr(0, Context->NoAlias);
+    if (Context->Prof) {
+      const auto Count = Context->Prof->getFunctionCount(
+          static_cast<uint32_t>(FuncID));
+      std::array<LLVM::Metadata, 2> EntryCount = {
+          LLVM::Metadata::getString(Context->LLContext,
+                                    "function_entry_count"sv),
+          LLVM::Metadata(Context->LLContext.getInt64(Count))};
+      F.Fn.setGlobalMetadata(LLVM::Core::Prof,
+                             LLVM::Metadata(Context->LLContext, EntryCount));
+      if (Count == 0) {
+        // Not executed in the profiling runs.
+        F.Fn.addFnAttr(Context->Cold);
+      }
+    }
 
     Context->Functions.emplace_back(TypeIdx, F, &Code);
   }
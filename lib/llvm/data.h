@@ -2,13 +2,23 @@
 // SPDX-FileCopyrightText: 2019-2022 Second State INC
 #pragma once
 
+#include "aot/target.h"
 #include "llvm.h"
 #include "llvm/data.h"
 
+#include <vector>
+
 struct WasmEdge::LLVM::Data::DataContext {
   LLVM::OrcThreadSafeContext TSContext;
   LLVM::Module LLModule;
   LLVM::TargetMachine TM;
+  /// The other function partitions compiled in their own contexts, in order.
+  std::vector<Data> Partitions;
+  /// CPU feature level of the target machine.
+  AOT::TargetLevel Target = AOT::TargetLevel::Host;
+  /// The fat binary variants of the other target levels, in the ascending
+  /// order.
+  std::vector<Data> Variants;
   DataContext() noexcept : TSContext(), LLModule(LLContext(), "wasm") {}
   LLVM::Context LLContext() noexcept { return TSContext.getContext(); }
 };
@@ -3,18 +3,90 @@
 
 #include "llvm/jit.h"
 #include "common/spdlog.h"
+#include "llvm/compiler.h"
+#include "system/fault.h"
 
 #include "data.h"
 #include "llvm.h"
 
+#include <algorithm>
+
 namespace LLVM = WasmEdge::LLVM;
 using namespace std::literals;
 
 namespace WasmEdge::LLVM {
 
+struct JITLibrary::LazyContext {
+  LazyContext(const Configure &Conf, const AST::Module &Module) noexcept
+      : Conf(Conf), Module(Module) {}
+  const Configure Conf;
+  /// Copied for the functions called after the module is released.
+  const AST::Module Module;
+#if LLVM_VERSION_MAJOR >= 13
+  OrcIRTransformLayer Layer;
+  OrcLazyCallThroughManager LCTM;
+  OrcIndirectStubsManager ISM;
+#endif
+};
+
+namespace {
+#if LLVM_VERSION_MAJOR >= 13
+/// The defined function Index of the code section to be compiled on its first
+/// call.
+struct LazyFunction {
+  JITLibrary::LazyContext *Context;
+  uint32_t Index;
+  /// Symbol name of the compiled function in the function index space.
+  std::string Name;
+};
+
+std::string getImplName(std::string_view Name) {
+  return fmt::format("{}.impl"sv, Name);
+}
+
+void materializeFunction(void *Ctx,
+                         LLVMOrcMaterializationResponsibilityRef MR) noexcept {
+  std::unique_ptr<LazyFunction> Func(static_cast<LazyFunction *>(Ctx));
+  auto &Context = *Func->Context;
+  spdlog::debug("lazy compile {} start"sv, Func->Name);
+  Compiler Compiler(Context.Conf);
+  auto Res = Compiler.compileLazyFunction(Context.Module, Func->Index);
+  if (!Res) {
+    spdlog::error("lazy compile {} failed"sv, Func->Name);
+    LLVMOrcMaterializationResponsibilityFailMaterialization(MR);
+    LLVMOrcDisposeMaterializationResponsibility(MR);
+    return;
+  }
+  // The stub holds the name of the function. The calls inside the module
+  // still refer to the function itself.
+  auto &DataContext = Res->extract();
+  DataContext.LLModule.getNamedFunction(Func->Name.c_str())
+      .setValueName(getImplName(Func->Name));
+  Context.Layer.emit(MR, OrcThreadSafeModule(DataContext.LLModule.release(),
+                                             DataContext.TSContext));
+}
+
+void discardFunction(void *, LLVMOrcJITDylibRef,
+                     LLVMOrcSymbolStringPoolEntryRef) noexcept {}
+
+void destroyFunction(void *Ctx) noexcept {
+  delete static_cast<LazyFunction *>(Ctx);
+}
+
+/// Landing address of the stubs when the callee fails to compile.
+[[noreturn]] void lazyCompileFailed() noexcept {
+  Fault::emitFault(ErrCode::Value::HostFuncError);
+}
+#endif
+} // namespace
+
 JITLibrary::JITLibrary(OrcLLJIT JIT) noexcept
     : J(std::make_unique<OrcLLJIT>(std::move(JIT)).release()) {}
 
+JITLibrary::JITLibrary(OrcLLJIT JIT, std::unique_ptr<LazyContext> L) noexcept
+    : J(std::make_unique<OrcLLJIT>(std::move(JIT)).release()),
+      Lazy(std::move(L)) {}
+
 JITLibrary::~JITLibrary() noexcept {
   std::unique_ptr<OrcLLJIT> JIT(std::exchange(J, nullptr));
 }
@@ -81,13 +153,125 @@ Expect<std::shared_ptr<Executable>> JIT::load(Data D) noexcept {
   }
 
   auto MainJD = J.getMainJITDylib();
+  auto AddModule = [&J, &MainJD](Data::DataContext &Context) noexcept {
+    if (auto Err = J.addLLVMIRModule(
+            MainJD, OrcThreadSafeModule(Context.LLModule.release(),
+                                        Context.TSContext))) {
+      spdlog::error("{}"sv, Err.message().string_view());
+      return false;
+    }
+    return true;
+  };
+  if (!AddModule(D.extract())) {
+    return Unexpect(ErrCode::Value::HostFuncError);
+  }
+  // The functions of the other partitions are resolved across the modules in
+  // the same JIT dylib.
+  for (auto &Partition : D.extract().Partitions) {
+    if (!AddModule(Partition.extract())) {
+      return Unexpect(ErrCode::Value::HostFuncError);
+    }
+  }
+
+  return std::make_shared<JITLibrary>(std::move(J));
+}
+
+Expect<std::shared_ptr<Executable>>
+JIT::loadLazy(const AST::Module &Module) noexcept {
+#if LLVM_VERSION_MAJOR >= 13
+  Compiler Compiler(Conf);
+  auto D = Compiler.compileLazy(Module);
+  if (!D) {
+    return Unexpect(D);
+  }
+
+  // Declared before the JIT to be released after it.
+  auto Lazy = std::make_unique<JITLibrary::LazyContext>(Conf, Module);
+  OrcLLJIT J;
+  if (auto Res = OrcLLJIT::create(); !Res) {
+    spdlog::error("{}"sv, Res.error().message().string_view());
+    return Unexpect(ErrCode::Value::HostFuncError);
+  } else {
+    J = std::move(*Res);
+  }
+  if (auto Res = OrcLazyCallThroughManager::create(
+          J.getTripleString(), J.getExecutionSession(),
+          reinterpret_cast<LLVMOrcJITTargetAddress>(&lazyCompileFailed));
+      !Res) {
+    spdlog::error("{}"sv, Res.error().message().string_view());
+    return Unexpect(ErrCode::Value::HostFuncError);
+  } else {
+    Lazy->LCTM = std::move(*Res);
+  }
+  Lazy->ISM = OrcIndirectStubsManager::create(J.getTripleString());
+  Lazy->Layer = J.getIRTransformLayer();
+
+  // The type wrappers and the intrinsics table.
+  auto MainJD = J.getMainJITDylib();
+  auto &Context = D->extract();
   if (auto Err = J.addLLVMIRModule(
-          MainJD,
-          OrcThreadSafeModule(LLModule.release(), D.extract().TSContext))) {
+          MainJD, OrcThreadSafeModule(Context.LLModule.release(),
+                                      Context.TSContext))) {
     spdlog::error("{}"sv, Err.message().string_view());
     return Unexpect(ErrCode::Value::HostFuncError);
   }
 
-  return std::make_shared<JITLibrary>(std::move(J));
+  // Each defined function is an unit compiled on the first lookup of its
+  // implementation symbol, and is called through the stub of its name.
+  const auto &Imports = Module.getImportSection().getContent();
+  const auto ImportFuncNum = static_cast<uint32_t>(
+      std::count_if(Imports.begin(), Imports.end(), [](const auto &ImpDesc) {
+        return ImpDesc.getExternalType() == ExternalType::Function;
+      }));
+  const auto CodeNum =
+      static_cast<uint32_t>(Module.getCodeSection().getContent().size());
+  const LLVMJITSymbolFlags Flags = {
+      LLVMJITSymbolGenericFlagsExported | LLVMJITSymbolGenericFlagsCallable,
+      0};
+  std::vector<LLVMOrcCSymbolAliasMapPair> Aliases;
+  Aliases.reserve(CodeNum);
+  for (uint32_t I = 0; I < CodeNum; ++I) {
+    auto Name = fmt::format("f{}"sv, ImportFuncNum + I);
+    const auto ImplName = getImplName(Name);
+    auto Symbol = J.mangleAndIntern(Name.c_str());
+    auto ImplSymbol = J.mangleAndIntern(ImplName.c_str());
+    LLVMOrcRetainSymbolStringPoolEntry(ImplSymbol);
+    LLVMOrcCSymbolFlagsMapPair ImplFlags = {ImplSymbol, Flags};
+    auto MU = LLVMOrcCreateCustomMaterializationUnit(
+        ImplName.c_str(), new LazyFunction{Lazy.get(), I, std::move(Name)},
+        &ImplFlags, 1, nullptr, materializeFunction, discardFunction,
+        destroyFunction);
+    if (auto Err = MainJD.define(MU)) {
+      spdlog::error("{}"sv, Err.message().string_view());
+      LLVMOrcReleaseSymbolStringPoolEntry(Symbol);
+      LLVMOrcReleaseSymbolStringPoolEntry(ImplSymbol);
+      for (auto &Alias : Aliases) {
+        LLVMOrcReleaseSymbolStringPoolEntry(Alias.Name);
+        LLVMOrcReleaseSymbolStringPoolEntry(Alias.Entry.Name);
+      }
+      return Unexpect(ErrCode::Value::HostFuncError);
+    }
+    Aliases.push_back({Symbol, {ImplSymbol, Flags}});
+  }
+  if (!Aliases.empty()) {
+    auto MU =
+        LLVMOrcLazyReexports(Lazy->LCTM.unwrap(), Lazy->ISM.unwrap(),
+                             MainJD.unwrap(), Aliases.data(), Aliases.size());
+    if (auto Err = MainJD.define(MU)) {
+      spdlog::error("{}"sv, Err.message().string_view());
+      return Unexpect(ErrCode::Value::HostFuncError);
+    }
+  }
+
+  return std::make_shared<JITLibrary>(std::move(J), std::move(Lazy));
+#else
+  // The lazy reexports are not available. Compile the whole module.
+  Compiler Compiler(Conf);
+  auto D = Compiler.compile(Module);
+  if (!D) {
+    return Unexpect(D);
+  }
+  return load(std::move(*D));
+#endif
 }
 } // namespace WasmEdge::LLVM
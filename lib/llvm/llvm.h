@@ -136,6 +136,8 @@ public:
 #endif
 
   static inline unsigned int InvariantGroup = 0;
+  static inline unsigned int InvariantLoad = 0;
+  static inline unsigned int Prof = 0;
 
 private:
   static inline std::once_flag Once;
@@ -214,6 +216,8 @@ private:
     UWTable = getEnumAttributeKind("uwtable"sv);
 
     InvariantGroup = getMetadataKind("invariant.group"sv);
+    InvariantLoad = getMetadataKind("invariant.load"sv);
+    Prof = getMetadataKind("prof"sv);
   }
 
   template <typename... ArgsT>
@@ -751,16 +755,25 @@ public:
   LLVM_FOR_EACH_VALUE_SUBCLASS(DECLARE_VALUE_CHECK)
 #undef DECLARE_VALUE_CHECK
 
+  uint64_t getZExtValue() const noexcept {
+    return LLVMConstIntGetZExtValue(Ref);
+  }
+
   std::string_view getValueName() noexcept {
     size_t Size;
     const auto Ptr = LLVMGetValueName2(Ref, &Size);
     return {Ptr, Size};
   }
+  void setValueName(std::string_view Name) noexcept {
+    LLVMSetValueName2(Ref, Name.data(), Name.size());
+  }
   inline void addFnAttr(const Attribute &A) noexcept;
   inline void addParamAttr(unsigned Index, const Attribute &A) noexcept;
   inline void addCallSiteAttribute(const Attribute &A) noexcept;
   inline void setMetadata(Context &C, unsigned int KindID,
                           Metadata Node) noexcept;
+  inline void setGlobalMetadata(unsigned int KindID,
+                                const Metadata &Node) noexcept;
 
   Value getFirstParam() noexcept { return LLVMGetFirstParam(Ref); }
   Value getNextParam() noexcept { return LLVMGetNextParam(Ref); }
@@ -843,6 +856,9 @@ public:
     Ref = LLVMMDNodeInContext2(C.unwrap(), Data, Size);
   }
   Metadata(Value V) noexcept : Ref(LLVMValueAsMetadata(V.unwrap())) {}
+  static Metadata getString(Context &C, std::string_view S) noexcept {
+    return LLVMMDStringInContext2(C.unwrap(), S.data(), S.size());
+  }
 
   constexpr operator bool() const noexcept { return Ref != nullptr; }
   constexpr auto &unwrap() const noexcept { return Ref; }
@@ -1011,6 +1027,10 @@ void Value::setMetadata(Context &C, unsigned int KindID,
                         Metadata Node) noexcept {
   LLVMSetMetadata(Ref, KindID, LLVMMetadataAsValue(C.unwrap(), Node.unwrap()));
 }
+void Value::setGlobalMetadata(unsigned int KindID,
+                              const Metadata &Node) noexcept {
+  LLVMGlobalSetMetadata(Ref, KindID, Node.unwrap());
+}
 
 static inline Message getDefaultTargetTriple() noexcept {
   return LLVMGetDefaultTargetTriple();
@@ -2087,6 +2107,18 @@ public:
     swap(LHS.Ref, RHS.Ref);
   }
 
+#if LLVM_VERSION_MAJOR >= 13
+  /// Define the symbols of the materialization unit. The unit is disposed on
+  /// failure.
+  Error define(LLVMOrcMaterializationUnitRef MU) noexcept {
+    if (auto Err = LLVMOrcJITDylibDefine(Ref, MU)) {
+      LLVMOrcDisposeMaterializationUnit(MU);
+      return Err;
+    }
+    return {};
+  }
+#endif
+
 private:
   LLVMOrcJITDylibRef Ref = nullptr;
 };
@@ -2121,10 +2153,104 @@ public:
     LLVMOrcIRTransformLayerSetTransform(Ref, TransformFunction, Ctx);
   }
 
+#if LLVM_VERSION_MAJOR >= 13
+  void emit(LLVMOrcMaterializationResponsibilityRef MR,
+            OrcThreadSafeModule TSM) noexcept {
+    LLVMOrcIRTransformLayerEmit(Ref, MR, TSM.release());
+  }
+#endif
+
 private:
   LLVMOrcIRTransformLayerRef Ref = nullptr;
 };
 
+#if LLVM_VERSION_MAJOR >= 13
+class OrcIndirectStubsManager {
+public:
+  constexpr OrcIndirectStubsManager() noexcept = default;
+  constexpr OrcIndirectStubsManager(LLVMOrcIndirectStubsManagerRef R) noexcept
+      : Ref(R) {}
+  OrcIndirectStubsManager(const OrcIndirectStubsManager &) = delete;
+  OrcIndirectStubsManager &operator=(const OrcIndirectStubsManager &) = delete;
+  OrcIndirectStubsManager(OrcIndirectStubsManager &&B) noexcept
+      : OrcIndirectStubsManager() {
+    swap(*this, B);
+  }
+  OrcIndirectStubsManager &operator=(OrcIndirectStubsManager &&B) noexcept {
+    swap(*this, B);
+    return *this;
+  }
+
+  ~OrcIndirectStubsManager() noexcept {
+    LLVMOrcDisposeIndirectStubsManager(Ref);
+  }
+
+  static OrcIndirectStubsManager create(const char *TargetTriple) noexcept {
+    return LLVMOrcCreateLocalIndirectStubsManager(TargetTriple);
+  }
+
+  constexpr operator bool() const noexcept { return Ref != nullptr; }
+  constexpr auto &unwrap() const noexcept { return Ref; }
+  constexpr auto &unwrap() noexcept { return Ref; }
+  friend void swap(OrcIndirectStubsManager &LHS,
+                   OrcIndirectStubsManager &RHS) noexcept {
+    using std::swap;
+    swap(LHS.Ref, RHS.Ref);
+  }
+
+private:
+  LLVMOrcIndirectStubsManagerRef Ref = nullptr;
+};
+
+class OrcLazyCallThroughManager {
+public:
+  constexpr OrcLazyCallThroughManager() noexcept = default;
+  constexpr OrcLazyCallThroughManager(
+      LLVMOrcLazyCallThroughManagerRef R) noexcept
+      : Ref(R) {}
+  OrcLazyCallThroughManager(const OrcLazyCallThroughManager &) = delete;
+  OrcLazyCallThroughManager &
+  operator=(const OrcLazyCallThroughManager &) = delete;
+  OrcLazyCallThroughManager(OrcLazyCallThroughManager &&B) noexcept
+      : OrcLazyCallThroughManager() {
+    swap(*this, B);
+  }
+  OrcLazyCallThroughManager &operator=(OrcLazyCallThroughManager &&B) noexcept {
+    swap(*this, B);
+    return *this;
+  }
+
+  ~OrcLazyCallThroughManager() noexcept {
+    LLVMOrcDisposeLazyCallThroughManager(Ref);
+  }
+
+  /// Create the manager of the stubs. The calls are redirected to the
+  /// ErrorHandlerAddr when the callee fails to materialize.
+  static cxx20::expected<OrcLazyCallThroughManager, Error>
+  create(const char *TargetTriple, LLVMOrcExecutionSessionRef ES,
+         LLVMOrcJITTargetAddress ErrorHandlerAddr) noexcept {
+    OrcLazyCallThroughManager Result;
+    if (auto Err = LLVMOrcCreateLocalLazyCallThroughManager(
+            TargetTriple, ES, ErrorHandlerAddr, &Result.Ref)) {
+      return cxx20::unexpected(Err);
+    }
+    return Result;
+  }
+
+  constexpr operator bool() const noexcept { return Ref != nullptr; }
+  constexpr auto &unwrap() const noexcept { return Ref; }
+  constexpr auto &unwrap() noexcept { return Ref; }
+  friend void swap(OrcLazyCallThroughManager &LHS,
+                   OrcLazyCallThroughManager &RHS) noexcept {
+    using std::swap;
+    swap(LHS.Ref, RHS.Ref);
+  }
+
+private:
+  LLVMOrcLazyCallThroughManagerRef Ref = nullptr;
+};
+#endif
+
 class OrcLLJIT {
 public:
   constexpr OrcLLJIT() noexcept = default;
@@ -2177,6 +2303,21 @@ public:
     return LLVMOrcLLJITGetIRTransformLayer(Ref);
   }
 
+#if LLVM_VERSION_MAJOR >= 13
+  LLVMOrcExecutionSessionRef getExecutionSession() noexcept {
+    return LLVMOrcLLJITGetExecutionSession(Ref);
+  }
+
+  const char *getTripleString() noexcept {
+    return LLVMOrcLLJITGetTripleString(Ref);
+  }
+
+  /// Get the retained symbol string of the name with the global prefix.
+  LLVMOrcSymbolStringPoolEntryRef mangleAndIntern(const char *Name) noexcept {
+    return LLVMOrcLLJITMangleAndIntern(Ref, Name);
+  }
+#endif
+
 private:
   LLVMOrcLLJITRef Ref = nullptr;
 
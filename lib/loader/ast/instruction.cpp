@@ -280,9 +280,29 @@ Expect<AST::InstrVec> Loader::loadInstrSeq(std::optional<uint64_t> SizeBound) {
                           ASTNodeAttr::Instruction);
     }
   }
+  // Release the growth capacity. The instruction sequences of all functions
+  // live as long as the module, so the slack is significant for large modules.
+  Instrs.shrink_to_fit();
   return Instrs;
 }
 
+// Load lazy function body. See "include/loader/loader.h".
+Expect<AST::InstrVec> Loader::loadLazyInstrSeq(Span<const Byte> Code,
+                                               bool HasData) {
+  std::lock_guard Lock(Mutex);
+  HasDataSection = HasData;
+  WASMType = InputType::WASM;
+  if (auto Res = FMgr.setCode(Code); unlikely(!Res)) {
+    return Unexpect(Res);
+  }
+  auto Res = loadInstrSeq(Code.size());
+  FMgr.reset();
+  if (unlikely(!Res)) {
+    spdlog::error(ErrInfo::InfoAST(ASTNodeAttr::Seg_Code));
+  }
+  return Res;
+}
+
 // Load instruction node. See "include/loader/loader.h".
 Expect<void> Loader::loadInstruction(AST::Instruction &Instr) {
   // Node: The instruction has checked for the proposals. Need to check their
@@ -310,18 +330,32 @@ Expect<void> Loader::loadInstruction(AST::Instruction &Instr) {
 
   auto readMemImmediate = [this, readU32, &Instr]() -> Expect<void> {
     Instr.getTargetIndex() = 0;
-    if (auto Res = readU32(Instr.getMemoryAlign()); unlikely(!Res)) {
+    uint32_t Align = 0;
+    if (auto Res = readU32(Align); unlikely(!Res)) {
       return Unexpect(Res);
     }
-    if (Conf.hasProposal(Proposal::MultiMemories) &&
-        Instr.getMemoryAlign() >= 64) {
-      Instr.getMemoryAlign() -= 64;
+    if (Conf.hasProposal(Proposal::MultiMemories) && Align >= 64) {
+      Align -= 64;
       if (auto Res = readU32(Instr.getTargetIndex()); unlikely(!Res)) {
         return Unexpect(Res);
       }
     }
-    if (auto Res = readU32(Instr.getMemoryOffset()); unlikely(!Res)) {
-      return Unexpect(Res);
+    Instr.setMemoryAlign(Align);
+    // The offset is u64 in memory64 proposal, and is checked against the
+    // address type of the memory in validation.
+    if (Conf.hasProposal(Proposal::Memory64)) {
+      if (auto Res = FMgr.readU64()) {
+        Instr.getMemoryOffset() = *Res;
+      } else {
+        return logLoadError(Res.error(), FMgr.getLastOffset(),
+                            ASTNodeAttr::Instruction);
+      }
+    } else {
+      uint32_t Offset = 0;
+      if (auto Res = readU32(Offset); unlikely(!Res)) {
+        return Unexpect(Res);
+      }
+      Instr.getMemoryOffset() = Offset;
     }
     return {};
   };
@@ -345,10 +345,15 @@ Expect<void> Loader::loadModuleAOT(AST::AOTSection &AOTSection) {
         AST::AOTSection NewAOTSection;
         VecMgr.setCode(Content);
         if (auto Res = loadSection(VecMgr, NewAOTSection)) {
-          // Also handle the duplicated AOT sections case.
-          // If the new AOT section discovered, use the new one.
-          WASMType = InputType::UniversalWASM;
-          AOTSection = std::move(NewAOTSection);
+          // Also handle the duplicated AOT sections case. The fat universal
+          // WASM has the AOT sections of several target levels, and the
+          // highest one supported by the host is used. For the same levels,
+          // use the new one.
+          if (WASMType != InputType::UniversalWASM ||
+              NewAOTSection.getTargetLevel() >= AOTSection.getTargetLevel()) {
+            WASMType = InputType::UniversalWASM;
+            AOTSection = std::move(NewAOTSection);
+          }
         } else {
           // If the new AOT section load failed, use the old one or the
           // interpreter mode.
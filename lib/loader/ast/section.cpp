@@ -3,6 +3,7 @@
 
 #include "loader/loader.h"
 
+#include "aot/target.h"
 #include "aot/version.h"
 #include "common/defines.h"
 #include <cstdint>
@@ -423,6 +424,20 @@ Expect<void> Loader::loadSection(FileMgr &VecMgr, AST::AOTSection &Sec) {
     return Unexpect(ErrCode::Value::MalformedSection);
   }
 
+  if (auto Res = VecMgr.readByte(); unlikely(!Res)) {
+    spdlog::info(Res.error());
+    spdlog::info("    AOT target level read error:{}", Res.error());
+    return Unexpect(Res);
+  } else {
+    Sec.setTargetLevel(*Res);
+  }
+  if (unlikely(!AOT::isHostSupported(
+          static_cast<AOT::TargetLevel>(Sec.getTargetLevel())))) {
+    spdlog::info(ErrCode::Value::MalformedSection);
+    spdlog::info("    AOT target level unsupported by the host CPU.");
+    return Unexpect(ErrCode::Value::MalformedSection);
+  }
+
   if (auto Res = VecMgr.readU64(); unlikely(!Res)) {
     spdlog::info(Res.error());
     spdlog::info("    AOT version address read error:{}", Res.error());
@@ -295,6 +295,28 @@ Expect<void> Loader::loadSegment(AST::CodeSegment &CodeSeg) {
     // For the AOT mode and not force interpreter in configure, skip the
     // function body.
     FMgr.seek(ExprSizeBound);
+  } else if (Conf.getRuntimeConfigure().isLazyValidation() &&
+             !Conf.getRuntimeConfigure().isEnableJIT()) {
+    // For the lazy validation mode, keep the raw function body and decode it
+    // at the first call.
+    if (unlikely(FMgr.getOffset() > ExprSizeBound)) {
+      return logLoadError(ErrCode::Value::SectionSizeMismatch,
+                          FMgr.getOffset(), ASTNodeAttr::Seg_Code);
+    }
+    auto Body = FMgr.readBytes(ExprSizeBound - FMgr.getOffset());
+    if (unlikely(!Body)) {
+      return logLoadError(Body.error(), FMgr.getLastOffset(),
+                          ASTNodeAttr::Seg_Code);
+    }
+    if (!LazyLoader) {
+      LazyLoader = std::make_shared<Loader>(Conf);
+    }
+    CodeSeg.setLazyDecoder(
+        [L = LazyLoader, HasData = HasDataSection,
+         Code = std::make_shared<const std::vector<Byte>>(std::move(*Body))]()
+            -> Expect<AST::InstrVec> {
+          return L->loadLazyInstrSeq(*Code, HasData);
+        });
   } else {
     // Read function body with expected expression size.
     if (auto Res = loadExpression(CodeSeg.getExpr(), ExprSizeBound);
@@ -3,6 +3,7 @@
 
 #include "loader/loader.h"
 
+#include <algorithm>
 #include <cstdint>
 
 namespace WasmEdge {
@@ -273,9 +274,15 @@ Expect<void> Loader::loadCompositeType(AST::CompositeType &CType) {
 }
 
 // Load binary to construct Limit node. See "include/loader/loader.h".
-Expect<void> Loader::loadLimit(AST::Limit &Lim) {
+Expect<void> Loader::loadLimit(AST::Limit &Lim, bool Allow64) {
   // Read limit.
   if (auto Res = FMgr.readByte()) {
+    // The 0x04 flag is for the 64-bit address type in memory64 proposal.
+    Lim.set64(Allow64 && Conf.hasProposal(Proposal::Memory64) &&
+              (*Res & 0x04U) != 0);
+    if (Lim.is64()) {
+      *Res &= ~0x04U;
+    }
     switch (static_cast<AST::Limit::LimitType>(*Res)) {
     case AST::Limit::LimitType::HasMin:
       Lim.setType(AST::Limit::LimitType::HasMin);
@@ -310,7 +317,23 @@ Expect<void> Loader::loadLimit(AST::Limit &Lim) {
   }
 
   // Read min and max number.
-  if (auto Res = FMgr.readU32()) {
+  auto readPages = [this, &Lim]() -> Expect<uint32_t> {
+    if (!Lim.is64()) {
+      return FMgr.readU32();
+    }
+    // The 64-bit limits are at most 2^48 pages. The page counts beyond 32-bit
+    // can never be allocated and are saturated.
+    if (auto Res = FMgr.readU64()) {
+      if (unlikely(*Res > (UINT64_C(1) << 48))) {
+        return Unexpect(ErrCode::Value::IntegerTooLarge);
+      }
+      return static_cast<uint32_t>(
+          std::min(*Res, static_cast<uint64_t>(UINT32_MAX)));
+    } else {
+      return Unexpect(Res);
+    }
+  };
+  if (auto Res = readPages()) {
     Lim.setMin(*Res);
     Lim.setMax(*Res);
   } else {
@@ -318,7 +341,7 @@ Expect<void> Loader::loadLimit(AST::Limit &Lim) {
                         ASTNodeAttr::Type_Limit);
   }
   if (Lim.hasMax()) {
-    if (auto Res = FMgr.readU32()) {
+    if (auto Res = readPages()) {
       Lim.setMax(*Res);
     } else {
       return logLoadError(Res.error(), FMgr.getLastOffset(),
@@ -405,7 +428,7 @@ Expect<void> Loader::loadType(AST::FunctionType &FuncType) {
 // Load binary to construct MemoryType node. See "include/loader/loader.h".
 Expect<void> Loader::loadType(AST::MemoryType &MemType) {
   // Read limit.
-  if (auto Res = loadLimit(MemType.getLimit()); !Res) {
+  if (auto Res = loadLimit(MemType.getLimit(), true); !Res) {
     spdlog::error(ErrInfo::InfoAST(ASTNodeAttr::Type_Memory));
     return Unexpect(Res);
   }
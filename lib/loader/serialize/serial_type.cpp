@@ -99,6 +99,7 @@ Serializer::serializeLimit(const AST::Limit &Lim,
   //       |0x01 + min:u32 + max:u32
   //       |0x02 + min:u32 (shared)
   //       |0x03 + min:u32 + max:u32 (shared)
+  //       |0x04-0x07 + min:u64 (+ max:u64) (64-bit address type)
   uint8_t Flag = 0;
   if (Lim.isShared()) {
     Flag = 0x02U;
@@ -115,6 +116,18 @@ Serializer::serializeLimit(const AST::Limit &Lim,
     return logSerializeError(ErrCode::Value::IntegerTooLarge,
                              ASTNodeAttr::Type_Limit);
   }
+  if (Lim.is64()) {
+    if (!Conf.hasProposal(Proposal::Memory64)) {
+      return logNeedProposal(ErrCode::Value::IntegerTooLarge,
+                             Proposal::Memory64, ASTNodeAttr::Type_Limit);
+    }
+    OutVec.push_back(Flag | 0x04U);
+    serializeU64(Lim.getMin(), OutVec);
+    if (Lim.hasMax()) {
+      serializeU64(Lim.getMax(), OutVec);
+    }
+    return {};
+  }
   OutVec.push_back(Flag);
   serializeU32(Lim.getMin(), OutVec);
   if (Lim.hasMax()) {
@@ -11,7 +11,19 @@
 #include "system/winapi.h"
 #elif defined(HAVE_MMAP) && defined(__x86_64__) || defined(__aarch64__) ||     \
     defined(__arm__) || (defined(__riscv) && __riscv_xlen == 64)
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+#include <optional>
 #include <sys/mman.h>
+#include <vector>
+#if WASMEDGE_OS_LINUX
+#include <array>
+#include <climits>
+#include <linux/mempolicy.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
 #else
 #include <cctype>
 #include <cstdlib>
@@ -31,10 +43,157 @@ static inline constexpr const uint64_t k4G = UINT64_C(0x100000000);
 static inline constexpr const uint64_t k12G = UINT64_C(0x300000000);
 #endif
 
+#if !WASMEDGE_OS_WINDOWS &&                                                    \
+    (defined(HAVE_MMAP) && defined(__x86_64__) || defined(__aarch64__) ||      \
+     (defined(__riscv) && __riscv_xlen == 64))
+static inline constexpr const uint64_t k2M = UINT64_C(0x200000);
+
+/// Reserve the region, which is 12 GiB for the guarded memories. For the huge
+/// pages and the pooled slots, align the region to 2 MiB by reserving more and
+/// trimming the both ends.
+uint8_t *reserve(uint64_t Size, bool Aligned) noexcept {
+  const uint64_t RawSize = Aligned ? Size + k2M : Size;
+  auto Raw = reinterpret_cast<uint8_t *>(
+      mmap(nullptr, RawSize, PROT_NONE,
+           MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0));
+  if (Raw == MAP_FAILED) {
+    return nullptr;
+  }
+  if (RawSize == Size) {
+    return Raw;
+  }
+  const uint64_t Head =
+      (k2M - (reinterpret_cast<uintptr_t>(Raw) & (k2M - 1))) & (k2M - 1);
+  if (Head > 0) {
+    munmap(Raw, Head);
+  }
+  munmap(Raw + Head + Size, k2M - Head);
+  return Raw + Head;
+}
+
+/// Commit the pages in [Begin, Begin + Size).
+bool commit(uint8_t *Begin, uint64_t Size, int Flags = 0) noexcept {
+  return mmap(Begin, Size, PROT_READ | PROT_WRITE,
+              MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED | Flags, -1,
+              0) != MAP_FAILED;
+}
+
+/// Decommit the pages in [Begin, Begin + Size) back to the reserved state. The
+/// physical pages are dropped.
+bool decommit(uint8_t *Begin, uint64_t Size) noexcept {
+  return mmap(Begin, Size, PROT_NONE,
+              MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED | MAP_NORESERVE, -1,
+              0) != MAP_FAILED;
+}
+
+/// Commit the pages with the hugetlbfs pages for the 2 MiB aligned chunks.
+bool commitHugeTLB(uint8_t *Begin, uint64_t Size) noexcept {
+#if defined(MAP_HUGETLB)
+  const auto Addr = reinterpret_cast<uintptr_t>(Begin);
+  const uintptr_t HBegin = (Addr + k2M - 1) & ~(k2M - 1);
+  const uintptr_t HEnd = (Addr + Size) & ~(k2M - 1);
+  if (HBegin < HEnd &&
+      commit(reinterpret_cast<uint8_t *>(HBegin), HEnd - HBegin,
+             MAP_HUGETLB)) {
+    return commit(Begin, HBegin - Addr) &&
+           (Addr + Size == HEnd ||
+            commit(reinterpret_cast<uint8_t *>(HEnd), Addr + Size - HEnd));
+  }
+#endif
+  return commit(Begin, Size);
+}
+
+/// Prefer the NUMA node of the current thread for the pages.
+void bindLocalNode(uint8_t *Begin [[maybe_unused]],
+                   uint64_t Size [[maybe_unused]]) noexcept {
+#if WASMEDGE_OS_LINUX && defined(SYS_getcpu) && defined(SYS_mbind)
+  unsigned int CPU = 0, Node = 0;
+  if (syscall(SYS_getcpu, &CPU, &Node, nullptr) != 0) {
+    return;
+  }
+  constexpr const unsigned int kBits = sizeof(unsigned long) * CHAR_BIT;
+  std::array<unsigned long, 16> NodeMask = {};
+  if (Node >= NodeMask.size() * kBits) {
+    return;
+  }
+  NodeMask[Node / kBits] = 1UL << (Node % kBits);
+  // Use the preferred policy to fall back to the other nodes rather than
+  // failing the page faults when the local node is exhausted.
+  syscall(SYS_mbind, Begin, Size, MPOL_PREFERRED, NodeMask.data(),
+          NodeMask.size() * kBits + 1, 0);
+#endif
+}
+
+/// Process-wide pool of the reserved 12 GiB slots. The released slots are
+/// recycled instead of being unmapped to avoid the reservation syscalls and
+/// the VMA lock contention in the instance churn.
+class SlotPool {
+public:
+  struct Slot {
+    /// Pointer to the linear memory, which is after the leading 4 GiB guard.
+    uint8_t *Pointer;
+    /// Committed bytes at the beginning of the slot.
+    uint64_t Resident;
+  };
+
+  static SlotPool &getInstance() noexcept {
+    static SlotPool Pool;
+    return Pool;
+  }
+
+  /// Take an idle slot. The slots are reserved at once in the first use.
+  std::optional<Slot> acquire(uint32_t Capacity) noexcept {
+    std::unique_lock<std::mutex> Lock(Mutex);
+    if (!Initialized) {
+      Initialized = true;
+      Idle.reserve(Capacity);
+      for (uint32_t I = 0; I < Capacity; ++I) {
+        if (auto Reserved = reserve(k12G, true)) {
+          Idle.push_back({Reserved + k4G, 0});
+        }
+      }
+    }
+    if (Idle.empty()) {
+      return std::nullopt;
+    }
+    Slot S = Idle.back();
+    Idle.pop_back();
+    return S;
+  }
+
+  /// Put back the slot. Returns false if the pool is full.
+  bool recycle(Slot S, uint32_t Capacity) noexcept {
+    std::unique_lock<std::mutex> Lock(Mutex);
+    if (Idle.size() >= Capacity) {
+      return false;
+    }
+    Idle.push_back(S);
+    return true;
+  }
+
+private:
+  std::mutex Mutex;
+  std::vector<Slot> Idle;
+  bool Initialized = false;
+};
+#endif
+
 } // namespace
 
-WASMEDGE_EXPORT uint8_t *Allocator::allocate(uint32_t PageCount) noexcept {
+WASMEDGE_EXPORT uint8_t *
+Allocator::allocate(uint32_t PageCount,
+                    Policy MemPolicy [[maybe_unused]]) noexcept {
 #if WASMEDGE_OS_WINDOWS
+  if (MemPolicy.ReservePages > 0) {
+    // Reserve the pages only without the guard region.
+    auto Reserved = reinterpret_cast<uint8_t *>(
+        winapi::VirtualAlloc(nullptr, MemPolicy.ReservePages * kPageSize,
+                             winapi::MEM_RESERVE_, winapi::PAGE_NOACCESS_));
+    if (Reserved == nullptr || PageCount == 0) {
+      return Reserved;
+    }
+    return resize(Reserved, 0, PageCount);
+  }
   auto Reserved = reinterpret_cast<uint8_t *>(winapi::VirtualAlloc(
       nullptr, k12G, winapi::MEM_RESERVE_, winapi::PAGE_NOACCESS_));
   if (Reserved == nullptr) {
@@ -50,16 +209,44 @@ WASMEDGE_EXPORT uint8_t *Allocator::allocate(uint32_t PageCount) noexcept {
   return Pointer;
 #elif defined(HAVE_MMAP) && defined(__x86_64__) || defined(__aarch64__) ||     \
     (defined(__riscv) && __riscv_xlen == 64)
-  auto Reserved = reinterpret_cast<uint8_t *>(
-      mmap(nullptr, k12G, PROT_NONE,
-           MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0));
-  if (Reserved == MAP_FAILED) {
+  if (MemPolicy.ReservePages > 0) {
+    // Reserve the pages only without the guard region.
+    auto Reserved = reserve(MemPolicy.ReservePages * kPageSize,
+                            MemPolicy.HugePageMode != HugePage::None);
+    if (Reserved == nullptr || PageCount == 0) {
+      return Reserved;
+    }
+    return resize(Reserved, 0, PageCount, MemPolicy);
+  }
+  if (MemPolicy.PoolSlots > 0) {
+    if (auto S = SlotPool::getInstance().acquire(MemPolicy.PoolSlots)) {
+      // Reuse the slot. Zero the resident pages and fit the committed pages
+      // to the page count.
+      const uint64_t Size = PageCount * kPageSize;
+      if (Size < S->Resident &&
+          !decommit(S->Pointer + Size, S->Resident - Size)) {
+        munmap(S->Pointer - k4G, k12G);
+        return nullptr;
+      }
+      std::memset(S->Pointer, 0, std::min(Size, S->Resident));
+      if (Size > S->Resident &&
+          resize(S->Pointer, static_cast<uint32_t>(S->Resident / kPageSize),
+                 PageCount, MemPolicy) == nullptr) {
+        munmap(S->Pointer - k4G, k12G);
+        return nullptr;
+      }
+      return S->Pointer;
+    }
+  }
+  auto Reserved = reserve(k12G, MemPolicy.HugePageMode != HugePage::None ||
+                                    MemPolicy.PoolSlots > 0);
+  if (Reserved == nullptr) {
     return nullptr;
   }
   if (PageCount == 0) {
     return Reserved + k4G;
   }
-  auto Pointer = resize(Reserved + k4G, 0, PageCount);
+  auto Pointer = resize(Reserved + k4G, 0, PageCount, MemPolicy);
   if (Pointer == nullptr) {
     return nullptr;
   }
@@ -74,9 +261,10 @@ WASMEDGE_EXPORT uint8_t *Allocator::allocate(uint32_t PageCount) noexcept {
 #endif
 }
 
-WASMEDGE_EXPORT uint8_t *Allocator::resize(uint8_t *Pointer,
-                                           uint32_t OldPageCount,
-                                           uint32_t NewPageCount) noexcept {
+WASMEDGE_EXPORT uint8_t *
+Allocator::resize(uint8_t *Pointer, uint32_t OldPageCount,
+                  uint32_t NewPageCount,
+                  Policy MemPolicy [[maybe_unused]]) noexcept {
   assuming(NewPageCount > OldPageCount);
 #if WASMEDGE_OS_WINDOWS
   if (winapi::VirtualAlloc(Pointer + OldPageCount * kPageSize,
@@ -88,10 +276,30 @@ WASMEDGE_EXPORT uint8_t *Allocator::resize(uint8_t *Pointer,
   return Pointer;
 #elif defined(HAVE_MMAP) && defined(__x86_64__) || defined(__aarch64__) ||     \
     (defined(__riscv) && __riscv_xlen == 64)
-  if (mmap(Pointer + OldPageCount * kPageSize,
-           (NewPageCount - OldPageCount) * kPageSize, PROT_READ | PROT_WRITE,
-           MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED, -1, 0) == MAP_FAILED) {
-    return nullptr;
+  uint8_t *Begin = Pointer + OldPageCount * kPageSize;
+  const uint64_t Size = (NewPageCount - OldPageCount) * kPageSize;
+  switch (MemPolicy.HugePageMode) {
+  case HugePage::HugeTLB:
+    if (!commitHugeTLB(Begin, Size)) {
+      return nullptr;
+    }
+    break;
+  case HugePage::Transparent:
+    if (!commit(Begin, Size)) {
+      return nullptr;
+    }
+#if defined(MADV_HUGEPAGE)
+    madvise(Begin, Size, MADV_HUGEPAGE);
+#endif
+    break;
+  default:
+    if (!commit(Begin, Size)) {
+      return nullptr;
+    }
+    break;
+  }
+  if (MemPolicy.NUMALocal) {
+    bindLocalNode(Begin, Size);
   }
   return Pointer;
 #else
@@ -106,20 +314,108 @@ WASMEDGE_EXPORT uint8_t *Allocator::resize(uint8_t *Pointer,
 #endif
 }
 
-WASMEDGE_EXPORT void Allocator::release(uint8_t *Pointer, uint32_t) noexcept {
+WASMEDGE_EXPORT bool Allocator::shrink(uint8_t *Pointer,
+                                       uint32_t OldPageCount,
+                                       uint32_t NewPageCount) noexcept {
+  assuming(NewPageCount <= OldPageCount);
+  if (NewPageCount == OldPageCount) {
+    return true;
+  }
+#if WASMEDGE_OS_WINDOWS
+  return winapi::VirtualFree(Pointer + NewPageCount * kPageSize,
+                             (OldPageCount - NewPageCount) * kPageSize,
+                             winapi::MEM_DECOMMIT_) != 0;
+#elif defined(HAVE_MMAP) && defined(__x86_64__) || defined(__aarch64__) ||     \
+    (defined(__riscv) && __riscv_xlen == 64)
+  return decommit(Pointer + NewPageCount * kPageSize,
+                  (OldPageCount - NewPageCount) * kPageSize);
+#else
+  // The pages are in the heap buffer. Only zero the dropped pages.
+  std::memset(Pointer + NewPageCount * kPageSize, 0,
+              (OldPageCount - NewPageCount) * kPageSize);
+  return true;
+#endif
+}
+
+WASMEDGE_EXPORT void
+Allocator::release(uint8_t *Pointer, uint32_t PageCount [[maybe_unused]],
+                   Policy MemPolicy [[maybe_unused]]) noexcept {
 #if WASMEDGE_OS_WINDOWS
-  winapi::VirtualFree(Pointer - k4G, 0, winapi::MEM_RELEASE_);
+  winapi::VirtualFree(MemPolicy.ReservePages > 0 ? Pointer : Pointer - k4G, 0,
+                      winapi::MEM_RELEASE_);
 #elif defined(HAVE_MMAP) && defined(__x86_64__) || defined(__aarch64__) ||     \
     (defined(__riscv) && __riscv_xlen == 64)
   if (Pointer == nullptr) {
     return;
   }
+  if (MemPolicy.ReservePages > 0) {
+    munmap(Pointer, MemPolicy.ReservePages * kPageSize);
+    return;
+  }
+  if (MemPolicy.PoolSlots > 0) {
+    // Keep the resident prefix committed and drop the other pages.
+    const uint64_t Size = PageCount * kPageSize;
+    const uint64_t Resident =
+        std::min(PageCount, MemPolicy.KeepResidentPages) * kPageSize;
+    if ((Size == Resident || decommit(Pointer + Resident, Size - Resident)) &&
+        SlotPool::getInstance().recycle({Pointer, Resident},
+                                        MemPolicy.PoolSlots)) {
+      return;
+    }
+  }
   munmap(Pointer - k4G, k12G);
 #else
   return std::free(Pointer);
 #endif
 }
 
+WASMEDGE_EXPORT uint8_t *Allocator::allocate_stack(uint64_t Size) noexcept {
+#if WASMEDGE_OS_WINDOWS
+  auto Pointer = reinterpret_cast<uint8_t *>(winapi::VirtualAlloc(
+      nullptr, Size + kPageSize, winapi::MEM_RESERVE_,
+      winapi::PAGE_NOACCESS_));
+  if (unlikely(Pointer == nullptr)) {
+    return nullptr;
+  }
+  if (unlikely(winapi::VirtualAlloc(Pointer, Size, winapi::MEM_COMMIT_,
+                                    winapi::PAGE_READWRITE_) == nullptr)) {
+    winapi::VirtualFree(Pointer, 0, winapi::MEM_RELEASE_);
+    return nullptr;
+  }
+  return Pointer;
+#elif defined(HAVE_MMAP)
+  // Reserve the guard page together, and only make the leading Size bytes
+  // accessible. The pages are not backed until touched.
+  auto Pointer = mmap(nullptr, Size + kPageSize, PROT_NONE,
+                      MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+  if (unlikely(Pointer == MAP_FAILED)) {
+    return nullptr;
+  }
+  if (unlikely(mprotect(Pointer, Size, PROT_READ | PROT_WRITE) != 0)) {
+    munmap(Pointer, Size + kPageSize);
+    return nullptr;
+  }
+  return reinterpret_cast<uint8_t *>(Pointer);
+#else
+  return reinterpret_cast<uint8_t *>(std::malloc(Size));
+#endif
+}
+
+WASMEDGE_EXPORT void
+Allocator::release_stack(uint8_t *Pointer,
+                         uint64_t Size [[maybe_unused]]) noexcept {
+  if (Pointer == nullptr) {
+    return;
+  }
+#if WASMEDGE_OS_WINDOWS
+  winapi::VirtualFree(Pointer, 0, winapi::MEM_RELEASE_);
+#elif defined(HAVE_MMAP)
+  munmap(Pointer, Size + kPageSize);
+#else
+  std::free(Pointer);
+#endif
+}
+
 uint8_t *Allocator::allocate_chunk(uint64_t Size) noexcept {
 #if WASMEDGE_OS_WINDOWS
   if (auto Pointer = winapi::VirtualAlloc(nullptr, Size, winapi::MEM_COMMIT_,
@@ -0,0 +1,134 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2019-2022 Second State INC
+
+#include "system/bulkmem.h"
+
+#include <atomic>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+#if WASMEDGE_OS_LINUX
+#include <unistd.h>
+#endif
+
+namespace WasmEdge {
+
+namespace {
+
+/// Get the last level cache size, or 8 MiB if unknown.
+uint64_t detectCacheSize() noexcept {
+#if WASMEDGE_OS_LINUX && defined(_SC_LEVEL3_CACHE_SIZE)
+  if (const long Size = sysconf(_SC_LEVEL3_CACHE_SIZE); Size > 0) {
+    return static_cast<uint64_t>(Size);
+  }
+  if (const long Size = sysconf(_SC_LEVEL2_CACHE_SIZE); Size > 0) {
+    return static_cast<uint64_t>(Size);
+  }
+#endif
+  return UINT64_C(8) << 20;
+}
+
+std::atomic<uint64_t> &getThreshold() noexcept {
+  static std::atomic<uint64_t> Threshold(detectCacheSize());
+  return Threshold;
+}
+
+#if defined(__x86_64__) || defined(_M_X64)
+// Only define the streaming helpers on the supported platform to avoid
+// -Wunused-function error when applying -Werror.
+static inline constexpr const uint64_t kLineSize = 64;
+
+bool isOverlapped(const uint8_t *Dst, const uint8_t *Src,
+                  uint64_t Len) noexcept {
+  const auto D = reinterpret_cast<uintptr_t>(Dst);
+  const auto S = reinterpret_cast<uintptr_t>(Src);
+  return D < S + Len && S < D + Len;
+}
+
+/// Get the bytes before the next cache line boundary of Dst.
+uint64_t getHeadSize(const uint8_t *Dst) noexcept {
+  return (kLineSize - (reinterpret_cast<uintptr_t>(Dst) & (kLineSize - 1))) &
+         (kLineSize - 1);
+}
+
+/// Copy the non-overlapping regions with the cache line aligned streaming
+/// stores.
+void streamCopy(uint8_t *Dst, const uint8_t *Src, uint64_t Len) noexcept {
+  const uint64_t Head = getHeadSize(Dst);
+  std::memcpy(Dst, Src, Head);
+  Dst += Head;
+  Src += Head;
+  Len -= Head;
+  for (; Len >= kLineSize; Len -= kLineSize) {
+    const auto *S = reinterpret_cast<const __m128i *>(Src);
+    auto *D = reinterpret_cast<__m128i *>(Dst);
+    const __m128i V0 = _mm_loadu_si128(S);
+    const __m128i V1 = _mm_loadu_si128(S + 1);
+    const __m128i V2 = _mm_loadu_si128(S + 2);
+    const __m128i V3 = _mm_loadu_si128(S + 3);
+    _mm_stream_si128(D, V0);
+    _mm_stream_si128(D + 1, V1);
+    _mm_stream_si128(D + 2, V2);
+    _mm_stream_si128(D + 3, V3);
+    Dst += kLineSize;
+    Src += kLineSize;
+  }
+  // Order the streaming stores before the following accesses.
+  _mm_sfence();
+  std::memcpy(Dst, Src, Len);
+}
+
+/// Fill with the cache line aligned streaming stores.
+void streamFill(uint8_t *Dst, uint8_t Val, uint64_t Len) noexcept {
+  const uint64_t Head = getHeadSize(Dst);
+  std::memset(Dst, Val, Head);
+  Dst += Head;
+  Len -= Head;
+  const __m128i V = _mm_set1_epi8(static_cast<char>(Val));
+  for (; Len >= kLineSize; Len -= kLineSize) {
+    auto *D = reinterpret_cast<__m128i *>(Dst);
+    _mm_stream_si128(D, V);
+    _mm_stream_si128(D + 1, V);
+    _mm_stream_si128(D + 2, V);
+    _mm_stream_si128(D + 3, V);
+    Dst += kLineSize;
+  }
+  _mm_sfence();
+  std::memset(Dst, Val, Len);
+}
+#endif
+
+} // namespace
+
+WASMEDGE_EXPORT uint64_t BulkMemory::getStreamingThreshold() noexcept {
+  return getThreshold().load(std::memory_order_relaxed);
+}
+
+WASMEDGE_EXPORT void BulkMemory::setStreamingThreshold(uint64_t Size) noexcept {
+  getThreshold().store(Size, std::memory_order_relaxed);
+}
+
+WASMEDGE_EXPORT void BulkMemory::copyLarge(uint8_t *Dst, const uint8_t *Src,
+                                           uint64_t Len) noexcept {
+#if defined(__x86_64__) || defined(_M_X64)
+  if (Len >= getStreamingThreshold() && !isOverlapped(Dst, Src, Len)) {
+    streamCopy(Dst, Src, Len);
+    return;
+  }
+#endif
+  std::memmove(Dst, Src, Len);
+}
+
+WASMEDGE_EXPORT void BulkMemory::fillLarge(uint8_t *Dst, uint8_t Val,
+                                           uint64_t Len) noexcept {
+#if defined(__x86_64__) || defined(_M_X64)
+  if (Len >= getStreamingThreshold()) {
+    streamFill(Dst, Val, Len);
+    return;
+  }
+#endif
+  std::memset(Dst, Val, Len);
+}
+
+} // namespace WasmEdge
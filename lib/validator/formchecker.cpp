@@ -37,6 +37,7 @@ void FormChecker::reset(bool CleanGlobal) {
     Funcs.clear();
     Tables.clear();
     Mems = 0;
+    MemAddrTypes.clear();
     Globals.clear();
     Datas.clear();
     Elems.clear();
@@ -84,7 +85,11 @@ void FormChecker::addTable(const AST::TableType &Tab) {
   Tables.push_back(Tab.getRefType());
 }
 
-void FormChecker::addMemory(const AST::MemoryType &) { Mems++; }
+void FormChecker::addMemory(const AST::MemoryType &Mem) {
+  Mems++;
+  MemAddrTypes.push_back(
+      ValType(Mem.getLimit().is64() ? TypeCode::I64 : TypeCode::I32));
+}
 
 void FormChecker::addGlobal(const AST::GlobalType &Glob, const bool IsImport) {
   // Type in global is confirmed in loading phase.
@@ -244,10 +249,23 @@ Expect<void> FormChecker::checkInstr(const AST::Instruction &Instr) {
                                           Instr.getMemoryAlign()));
       return Unexpect(ErrCode::Value::InvalidAlignment);
     }
-    if (CheckLane) {
-      return checkLaneAndTrans(128 / N, Take, Put);
-    }
-    return StackTrans(Take, Put);
+    auto Trans = [&](Span<const ValType> T) -> Expect<void> {
+      if (CheckLane) {
+        return checkLaneAndTrans(128 / N, T, Put);
+      }
+      return StackTrans(T, Put);
+    };
+    if (getMemoryAddrType(Instr.getTargetIndex()).getCode() == TypeCode::I64) {
+      // The address operand is i64 for the 64-bit memories.
+      std::vector<ValType> Take64(Take.begin(), Take.end());
+      Take64[0] = ValType(TypeCode::I64);
+      return Trans(Take64);
+    }
+    if (Instr.getMemoryOffset() > std::numeric_limits<uint32_t>::max()) {
+      spdlog::error(ErrCode::Value::InvalidMemOffset);
+      return Unexpect(ErrCode::Value::InvalidMemOffset);
+    }
+    return Trans(Take);
   };
 
   // Helper lambda for checking value types matching.
@@ -1429,9 +1447,10 @@ Expect<void> FormChecker::checkInstr(const AST::Instruction &Instr) {
     return checkAlignAndTrans(
         32, {ValType(TypeCode::I32), ValType(TypeCode::I64)}, {});
   case OpCode::Memory__size:
-    return checkMemAndTrans({}, {ValType(TypeCode::I32)});
+    return checkMemAndTrans({}, {getMemoryAddrType(Instr.getTargetIndex())});
   case OpCode::Memory__grow:
-    return checkMemAndTrans({ValType(TypeCode::I32)}, {ValType(TypeCode::I32)});
+    return checkMemAndTrans({getMemoryAddrType(Instr.getTargetIndex())},
+                            {getMemoryAddrType(Instr.getTargetIndex())});
   case OpCode::Memory__init:
     // Check the target memory index. Memory index should be checked first.
     if (Instr.getTargetIndex() >= Mems) {
@@ -1445,20 +1464,28 @@ Expect<void> FormChecker::checkInstr(const AST::Instruction &Instr) {
                            ErrInfo::IndexCategory::Data, Instr.getSourceIndex(),
                            static_cast<uint32_t>(Datas.size()));
     }
-    return StackTrans({ValType(TypeCode::I32), ValType(TypeCode::I32),
-                       ValType(TypeCode::I32)},
+    return StackTrans({getMemoryAddrType(Instr.getTargetIndex()),
+                       ValType(TypeCode::I32), ValType(TypeCode::I32)},
                       {});
-  case OpCode::Memory__copy:
+  case OpCode::Memory__copy: {
     /// Check the source memory index.
     if (Instr.getSourceIndex() >= Mems) {
       return logOutOfRange(ErrCode::Value::InvalidMemoryIdx,
                            ErrInfo::IndexCategory::Memory,
                            Instr.getSourceIndex(), Mems);
     }
-    [[fallthrough]];
+    // The length is i64 only if both memories are 64-bit.
+    const ValType DstType = getMemoryAddrType(Instr.getTargetIndex());
+    const ValType SrcType = getMemoryAddrType(Instr.getSourceIndex());
+    return checkMemAndTrans(
+        {DstType, SrcType,
+         DstType.getCode() == TypeCode::I64 ? SrcType : DstType},
+        {});
+  }
   case OpCode::Memory__fill:
-    return checkMemAndTrans({ValType(TypeCode::I32), ValType(TypeCode::I32),
-                             ValType(TypeCode::I32)},
+    return checkMemAndTrans({getMemoryAddrType(Instr.getTargetIndex()),
+                             ValType(TypeCode::I32),
+                             getMemoryAddrType(Instr.getTargetIndex())},
                             {});
   case OpCode::Data__drop:
     // Check the target data index.
@@ -38,6 +38,7 @@ Expect<void> Validator::validate(const AST::Component::Component &Comp) {
 Expect<void> Validator::validate(const AST::Module &Mod) {
   // https://webassembly.github.io/spec/core/valid/modules.html
   Checker.reset(true);
+  LazyContext.reset();
 
   // Validate and register type section.
   if (auto Res = validate(Mod.getTypeSection()); !Res) {
@@ -235,8 +236,10 @@ Expect<void> Validator::validate(const AST::MemoryType &Mem) {
     spdlog::error(ErrInfo::InfoAST(ASTNodeAttr::Type_Limit));
     return Unexpect(Res);
   }
-  if (Lim.getMin() > LIMIT_MEMORYTYPE ||
-      (Lim.hasMax() && Lim.getMax() > LIMIT_MEMORYTYPE)) {
+  // The 64-bit limits are checked to be at most 2^48 pages in loading.
+  if (!Lim.is64() &&
+      (Lim.getMin() > LIMIT_MEMORYTYPE ||
+       (Lim.hasMax() && Lim.getMax() > LIMIT_MEMORYTYPE))) {
     spdlog::error(ErrCode::Value::InvalidMemPages);
     spdlog::error(ErrInfo::InfoLimit(Lim.hasMax(), Lim.getMin(), Lim.getMax()));
     return Unexpect(ErrCode::Value::InvalidMemPages);
@@ -363,6 +366,10 @@ Expect<void> Validator::validate(const AST::CodeSegment &CodeSeg,
       Checker.getTypes()[TypeIdx]->getCompositeType().getFuncType();
   // Reset stack in FormChecker.
   Checker.reset();
+  if (CodeSeg.getLazyDecoder() && !LazyContext) {
+    // Keep the module context for the lazy function bodies.
+    LazyContext = std::make_shared<const FormChecker>(Checker);
+  }
   // Add parameters into this frame.
   for (auto &Type : FuncType.getParamTypes()) {
     // Local passed as function parameters should be initialized.
@@ -378,6 +385,38 @@ Expect<void> Validator::validate(const AST::CodeSegment &CodeSeg,
       Checker.addLocal(Val.second, false);
     }
   }
+  if (CodeSeg.getLazyDecoder()) {
+    // Lazy validation mode: the function body will be decoded and validated at
+    // the first call with the kept module context. The defined types will be
+    // replaced by the ones of the module instance.
+    const_cast<AST::CodeSegment &>(CodeSeg).setLazyChecker(
+        [Context = LazyContext, TypeIdx,
+         Locals = std::vector<std::pair<uint32_t, ValType>>(
+             CodeSeg.getLocals().begin(), CodeSeg.getLocals().end())](
+            AST::InstrView Instrs,
+            Span<const AST::SubType *const> Types) -> Expect<void> {
+          FormChecker LazyChecker(*Context);
+          LazyChecker.getTypes().assign(Types.begin(), Types.end());
+          LazyChecker.reset();
+          const auto &Type = Types[TypeIdx]->getCompositeType().getFuncType();
+          for (auto &VType : Type.getParamTypes()) {
+            LazyChecker.addLocal(VType, true);
+          }
+          for (auto Val : Locals) {
+            for (uint32_t Cnt = 0; Cnt < Val.first; ++Cnt) {
+              LazyChecker.addLocal(Val.second, false);
+            }
+          }
+          if (auto Res = LazyChecker.validate(Instrs, Type.getReturnTypes());
+              !Res) {
+            spdlog::error(ErrInfo::InfoAST(ASTNodeAttr::Expression));
+            spdlog::error(ErrInfo::InfoAST(ASTNodeAttr::Seg_Code));
+            return Unexpect(Res);
+          }
+          return {};
+        });
+    return {};
+  }
   // Validate function body expression.
   if (auto Res = Checker.validate(CodeSeg.getExpr().getInstrs(),
                                   FuncType.getReturnTypes());
@@ -399,9 +438,10 @@ Expect<void> Validator::validate(const AST::DataSegment &DataSeg) {
                                              DataSeg.getIdx(), MemNum));
       return Unexpect(ErrCode::Value::InvalidMemoryIdx);
     }
-    // Check memory initialization is a const expression.
-    if (auto Res = validateConstExpr(DataSeg.getExpr().getInstrs(),
-                                     {ValType(TypeCode::I32)});
+    // Check memory initialization is a const expression of the address type.
+    if (auto Res =
+            validateConstExpr(DataSeg.getExpr().getInstrs(),
+                              {Checker.getMemoryAddrType(DataSeg.getIdx())});
         !Res) {
       spdlog::error(ErrInfo::InfoAST(ASTNodeAttr::Expression));
       return Unexpect(Res);
@@ -0,0 +1,125 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2019-2022 Second State INC
+
+#include "vm/tierup.h"
+
+#include "common/spdlog.h"
+#include "executor/executor.h"
+
+#ifdef WASMEDGE_USE_LLVM
+#include "llvm/compiler.h"
+#include "llvm/jit.h"
+#endif
+
+#include <algorithm>
+
+using namespace std::literals;
+
+namespace WasmEdge {
+namespace VM {
+
+TierUpCompiler::TierUpCompiler(const Configure &C,
+                               const AST::Module &M) noexcept
+    : Conf(C), Mod(M), Pool(1) {
+  const auto &Imports = Mod.getImportSection().getContent();
+  ImportFuncNum = static_cast<uint32_t>(
+      std::count_if(Imports.begin(), Imports.end(), [](const auto &ImpDesc) {
+        return ImpDesc.getExternalType() == ExternalType::Function;
+      }));
+}
+
+TierUpCompiler::~TierUpCompiler() noexcept {
+  Stopped.store(true, std::memory_order_relaxed);
+}
+
+bool TierUpCompiler::isSupported(const Configure &Conf,
+                                 const AST::Module &Mod) noexcept {
+  // The function bodies are not decoded in the lazy validation mode.
+  if (Conf.getRuntimeConfigure().isLazyValidation()) {
+    return false;
+  }
+  // TODO: GC - AOT: implement other composite types.
+  const auto &SubTypes = Mod.getTypeSection().getContent();
+  if (std::any_of(SubTypes.begin(), SubTypes.end(), [](const auto &SubType) {
+        return !SubType.getCompositeType().isFunc();
+      })) {
+    return false;
+  }
+  // The compiled code relies on the guard region of the 32-bit addresses.
+  const auto &MemTypes = Mod.getMemorySection().getContent();
+  const auto &Imports = Mod.getImportSection().getContent();
+  return std::none_of(MemTypes.begin(), MemTypes.end(),
+                      [](const AST::MemoryType &MemType) {
+                        return MemType.getLimit().is64();
+                      }) &&
+         std::none_of(Imports.begin(), Imports.end(),
+                      [](const AST::ImportDesc &ImpDesc) {
+                        return ImpDesc.getExternalType() ==
+                                   ExternalType::Memory &&
+                               ImpDesc.getExternalMemoryType()
+                                   .getLimit()
+                                   .is64();
+                      });
+}
+
+void TierUpCompiler::submit(const Runtime::Instance::FunctionInstance &Func) {
+  if (Func.getModule() != ModInst.load(std::memory_order_acquire)) {
+    // Functions of the other modules, or hot in the instantiation.
+    return;
+  }
+  Pool.submit([this, &Func]() { compile(Func); });
+}
+
+void TierUpCompiler::compile(
+    const Runtime::Instance::FunctionInstance &Func) noexcept {
+  if (Stopped.load(std::memory_order_relaxed)) {
+    return;
+  }
+  const auto *Inst = ModInst.load(std::memory_order_acquire);
+  const uint32_t FuncNum = Inst->getFuncNum();
+  uint32_t Index = ImportFuncNum;
+  while (Index < FuncNum && Inst->unsafeGetFunction(Index) != &Func) {
+    ++Index;
+  }
+  if (Index == FuncNum) {
+    return;
+  }
+
+#ifdef WASMEDGE_USE_LLVM
+  LLVM::Compiler Compiler(Conf);
+  LLVM::JIT JIT(Conf);
+  auto Res = Compiler.compileFunction(Mod, Index - ImportFuncNum);
+  if (!Res) {
+    spdlog::warn("Tier-up of function {} failed. Error code: {}, keep in "
+                 "interpreter mode."sv,
+                 Index, static_cast<uint32_t>(Res.error()));
+    return;
+  }
+  auto Lib = JIT.load(std::move(*Res));
+  if (!Lib) {
+    spdlog::warn("Tier-up of function {} failed. Error code: {}, keep in "
+                 "interpreter mode."sv,
+                 Index, static_cast<uint32_t>(Lib.error()));
+    return;
+  }
+
+  const auto &SubTypes = Mod.getTypeSection().getContent();
+  auto TypeSymbols = (*Lib)->getTypes(SubTypes.size());
+  auto CodeSymbols = (*Lib)->getCodes(Index, 1);
+  auto IntrinsicsSymbol = (*Lib)->getIntrinsics();
+  if (TypeSymbols.size() != SubTypes.size() || CodeSymbols.size() != 1 ||
+      !CodeSymbols[0] || !IntrinsicsSymbol) {
+    spdlog::warn("Tier-up of function {} failed. Symbols not found, keep in "
+                 "interpreter mode."sv,
+                 Index);
+    return;
+  }
+  *IntrinsicsSymbol = &Executor::Executor::Intrinsics;
+  Func.setTierUpSymbol(std::move(TypeSymbols[Func.getTypeIndex()]),
+                       std::move(CodeSymbols[0]));
+  spdlog::debug("Tier-up of function {} done."sv, Index);
+#endif
+}
+
+} // namespace VM
+} // namespace WasmEdge
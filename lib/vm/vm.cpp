@@ -6,9 +6,14 @@
 #include "ast/module.h"
 #include "host/wasi/wasimodule.h"
 #include "plugin/plugin.h"
+#include "llvm/codegen.h"
 #include "llvm/compiler.h"
 #include "llvm/jit.h"
 
+#ifdef WASMEDGE_USE_LLVM
+#include "aot/cache.h"
+#endif
+
 #include "host/mock/wasi_crypto_module.h"
 #include "host/mock/wasi_logging_module.h"
 #include "host/mock/wasi_nn_module.h"
@@ -18,7 +23,10 @@
 #include "host/mock/wasmedge_tensorflow_module.h"
 #include "host/mock/wasmedge_tensorflowlite_module.h"
 #include "validator/validator.h"
+#include <algorithm>
+#include <array>
 #include <memory>
+#include <random>
 #include <variant>
 
 namespace WasmEdge {
@@ -247,6 +255,7 @@ VM::unsafeRunWasmFile(const std::filesystem::path &Path, std::string_view Func,
         VisitUnit<Expect<std::vector<std::pair<ValVariant, ValType>>>>(
             [&](auto &M)
                 -> Expect<std::vector<std::pair<ValVariant, ValType>>> {
+              unsafeStopTierUp();
               Mod = std::move(M);
               return unsafeRunWasmFile(*Mod, Func, Params, ParamTypes);
             },
@@ -276,6 +285,7 @@ VM::unsafeRunWasmFile(Span<const Byte> Code, std::string_view Func,
         VisitUnit<Expect<std::vector<std::pair<ValVariant, ValType>>>>(
             [&](auto &M)
                 -> Expect<std::vector<std::pair<ValVariant, ValType>>> {
+              unsafeStopTierUp();
               Mod = std::move(M);
               return unsafeRunWasmFile(*Mod, Func, Params, ParamTypes);
             },
@@ -318,6 +328,7 @@ VM::unsafeRunWasmFile(const AST::Module &Module, std::string_view Func,
   if (auto Res = ValidatorEngine.validate(Module); !Res) {
     return Unexpect(Res);
   }
+  unsafeStopTierUp();
   if (auto Res = ExecutorEngine.instantiateModule(StoreRef, Module)) {
     ActiveModInst = std::move(*Res);
   } else {
@@ -360,7 +371,8 @@ VM::asyncRunWasmFile(const std::filesystem::path &Path, std::string_view Func,
   Expect<std::vector<std::pair<ValVariant, ValType>>> (VM::*FPtr)(
       const std::filesystem::path &, std::string_view, Span<const ValVariant>,
       Span<const ValType>) = &VM::runWasmFile;
-  return {FPtr,
+  return {ExecutorEngine.getAsyncPool(),
+          FPtr,
           *this,
           std::filesystem::path(Path),
           std::string(Func),
@@ -375,7 +387,8 @@ VM::asyncRunWasmFile(Span<const Byte> Code, std::string_view Func,
   Expect<std::vector<std::pair<ValVariant, ValType>>> (VM::*FPtr)(
       Span<const Byte>, std::string_view, Span<const ValVariant>,
       Span<const ValType>) = &VM::runWasmFile;
-  return {FPtr,
+  return {ExecutorEngine.getAsyncPool(),
+          FPtr,
           *this,
           Code,
           std::string(Func),
@@ -390,7 +403,8 @@ VM::asyncRunWasmFile(const AST::Module &Module, std::string_view Func,
   Expect<std::vector<std::pair<ValVariant, ValType>>> (VM::*FPtr)(
       const AST::Module &, std::string_view, Span<const ValVariant>,
       Span<const ValType>) = &VM::runWasmFile;
-  return {FPtr,
+  return {ExecutorEngine.getAsyncPool(),
+          FPtr,
           *this,
           Module,
           std::string(Func),
@@ -400,10 +414,27 @@ VM::asyncRunWasmFile(const AST::Module &Module, std::string_view Func,
 
 Expect<void> VM::unsafeLoadWasm(const std::filesystem::path &Path) {
   // If not load successfully, the previous status will be reserved.
+  if (Conf.getRuntimeConfigure().isEnableAOTCache()) {
+    auto Code = LoaderEngine.loadFile(Path);
+    if (!Code) {
+      return Unexpect(Code);
+    }
+    auto Cached = unsafeLoadCachedModule(*Code);
+    if (!Cached) {
+      return Unexpect(Cached);
+    }
+    if (*Cached) {
+      unsafeStopTierUp();
+      Mod = std::move(*Cached);
+      Stage = VMStage::Loaded;
+      return {};
+    }
+  }
   auto Res = LoaderEngine.parseWasmUnit(Path);
   if (!Res) {
     return Unexpect(Res);
   }
+  unsafeStopTierUp();
   std::visit(VisitUnit<void>([&](auto &M) -> void { Mod = std::move(M); },
                              [&](auto &C) -> void { Comp = std::move(C); }),
              *Res);
@@ -413,10 +444,23 @@ Expect<void> VM::unsafeLoadWasm(const std::filesystem::path &Path) {
 
 Expect<void> VM::unsafeLoadWasm(Span<const Byte> Code) {
   // If not load successfully, the previous status will be reserved.
+  if (Conf.getRuntimeConfigure().isEnableAOTCache()) {
+    auto Cached = unsafeLoadCachedModule(Code);
+    if (!Cached) {
+      return Unexpect(Cached);
+    }
+    if (*Cached) {
+      unsafeStopTierUp();
+      Mod = std::move(*Cached);
+      Stage = VMStage::Loaded;
+      return {};
+    }
+  }
   auto Res = LoaderEngine.parseWasmUnit(Code);
   if (!Res) {
     return Unexpect(Res);
   }
+  unsafeStopTierUp();
   std::visit(VisitUnit<void>([&](auto &M) -> void { Mod = std::move(M); },
                              [&](auto &C) -> void { Comp = std::move(C); }),
              *Res);
@@ -425,6 +469,7 @@ Expect<void> VM::unsafeLoadWasm(Span<const Byte> Code) {
 }
 
 Expect<void> VM::unsafeLoadWasm(const AST::Module &Module) {
+  unsafeStopTierUp();
   Mod = std::make_unique<AST::Module>(Module);
   Stage = VMStage::Loaded;
   return {};
@@ -476,11 +521,32 @@ Expect<void> VM::unsafeInstantiate() {
   }
 
   if (Mod) {
+    unsafeStopTierUp();
     if (Conf.getRuntimeConfigure().isEnableJIT() && !Mod->getSymbol()) {
 #ifdef WASMEDGE_USE_LLVM
       LLVM::Compiler Compiler(Conf);
       LLVM::JIT JIT(Conf);
-      if (auto Res = Compiler.compile(*Mod); !Res) {
+      if (Conf.getRuntimeConfigure().isEnableTieredJIT() &&
+          TierUpCompiler::isSupported(Conf, *Mod)) {
+        // Start in the interpreter, and compile the hot functions in the
+        // background after the instantiation.
+        TierUp = std::make_unique<TierUpCompiler>(Conf, *Mod);
+        ExecutorEngine.registerTierUpFunction(
+            [Ptr = TierUp.get()](
+                const Runtime::Instance::FunctionInstance &Func) {
+              Ptr->submit(Func);
+            });
+      } else if (Conf.getRuntimeConfigure().isEnableLazyJIT()) {
+        // Compile each function on its first call.
+        if (auto Res = JIT.loadLazy(*Mod); !Res) {
+          const auto Err = static_cast<uint32_t>(Res.error());
+          spdlog::warn(
+              "JIT failed. Error code: {}, use interpreter mode instead."sv,
+              Err);
+        } else {
+          LoaderEngine.loadExecutable(*Mod, std::move(*Res));
+        }
+      } else if (auto Res = Compiler.compile(*Mod); !Res) {
         const auto Err = static_cast<uint32_t>(Res.error());
         spdlog::error(
             "Compilation failed. Error code: {}, use interpreter mode instead."sv,
@@ -500,8 +566,12 @@ Expect<void> VM::unsafeInstantiate() {
     if (auto Res = ExecutorEngine.instantiateModule(StoreRef, *Mod)) {
       Stage = VMStage::Instantiated;
       ActiveModInst = std::move(*Res);
+      if (TierUp) {
+        TierUp->setModule(ActiveModInst.get());
+      }
       return {};
     } else {
+      unsafeStopTierUp();
       return Unexpect(Res);
     }
   } else if (Comp) {
@@ -575,7 +645,10 @@ VM::asyncExecute(std::string_view Func, Span<const ValVariant> Params,
   Expect<std::vector<std::pair<ValVariant, ValType>>> (VM::*FPtr)(
       std::string_view, Span<const ValVariant>, Span<const ValType>) =
       &VM::execute;
-  return {FPtr, *this, std::string(Func),
+  return {ExecutorEngine.getAsyncPool(),
+          FPtr,
+          *this,
+          std::string(Func),
           std::vector(Params.begin(), Params.end()),
           std::vector(ParamTypes.begin(), ParamTypes.end())};
 }
@@ -587,7 +660,8 @@ VM::asyncExecute(std::string_view ModName, std::string_view Func,
   Expect<std::vector<std::pair<ValVariant, ValType>>> (VM::*FPtr)(
       std::string_view, std::string_view, Span<const ValVariant>,
       Span<const ValType>) = &VM::execute;
-  return {FPtr,
+  return {ExecutorEngine.getAsyncPool(),
+          FPtr,
           *this,
           std::string(ModName),
           std::string(Func),
@@ -596,6 +670,7 @@ VM::asyncExecute(std::string_view ModName, std::string_view Func,
 }
 
 void VM::unsafeCleanup() {
+  unsafeStopTierUp();
   if (Mod) {
     Mod.reset();
   }
@@ -619,6 +694,105 @@ void VM::unsafeCleanup() {
   Stage = VMStage::Inited;
 }
 
+void VM::unsafeStopTierUp() {
+  if (TierUp) {
+    ExecutorEngine.registerTierUpFunction(nullptr);
+    TierUp.reset();
+  }
+}
+
+Expect<std::unique_ptr<AST::Module>>
+VM::unsafeLoadCachedModule(Span<const Byte> Code) {
+#ifdef WASMEDGE_USE_LLVM
+  // Only the WASM modules are compiled. The components and the shared
+  // libraries are loaded as usual.
+  static constexpr std::array<Byte, 8> ModuleHeader = {
+      0x00, 0x61, 0x73, 0x6D, 0x01, 0x00, 0x00, 0x00};
+  if (Conf.getRuntimeConfigure().isForceInterpreter() ||
+      Code.size() < ModuleHeader.size() ||
+      !std::equal(ModuleHeader.begin(), ModuleHeader.end(), Code.begin())) {
+    return nullptr;
+  }
+  auto Res = LoaderEngine.parseModule(Code);
+  if (!Res) {
+    return Unexpect(Res);
+  }
+  if ((*Res)->getSymbol()) {
+    // The universal WASM with the compiled code.
+    return std::move(*Res);
+  }
+
+  LLVM::Compiler Compiler(Conf);
+  auto Path = AOT::Cache::getPath(Code, AOT::Cache::StorageScope::Local,
+                                  "aot"sv, Compiler.getCacheKey());
+  std::error_code ErrCode;
+  if (Path) {
+    std::filesystem::create_directories(Path->parent_path(), ErrCode);
+  }
+  if (!Path || ErrCode) {
+    spdlog::warn("AOT cache is unavailable, load without the cache."sv);
+    return std::move(*Res);
+  }
+
+  // Wait for the other processes compiling the same module, and reuse the
+  // published code of them.
+  AOT::Cache::Lock Lock(*Path);
+  if (std::filesystem::exists(*Path, ErrCode)) {
+    if (auto Cached = LoaderEngine.parseModule(*Path);
+        Cached && (*Cached)->getSymbol()) {
+      AOT::Cache::touch(*Path);
+      return std::move(*Cached);
+    }
+    spdlog::warn("AOT cache {} is stale, compile it again."sv,
+                 Path->u8string());
+  }
+
+  // The module is compiled after validation. The invalid module is returned
+  // and reported in the validation later.
+  if (auto Check = ValidatorEngine.validate(**Res); !Check) {
+    return std::move(*Res);
+  }
+  auto Data = Compiler.compile(**Res);
+  if (!Data) {
+    spdlog::warn("Compilation failed. Error code: {}, load without the "
+                 "cache."sv,
+                 static_cast<uint32_t>(Data.error()));
+    return std::move(*Res);
+  }
+  // Publish the universal WASM atomically by renaming in the same directory.
+  Configure CodeGenConf(Conf);
+  CodeGenConf.getCompilerConfigure().setOutputFormat(
+      CompilerConfigure::OutputFormat::Wasm);
+  LLVM::CodeGen CodeGen(CodeGenConf);
+  auto TempPath = *Path;
+  TempPath += fmt::format(".{:08x}.tmp"sv, std::random_device()());
+  if (auto Gen = CodeGen.codegen(Code, std::move(*Data), TempPath); !Gen) {
+    spdlog::warn("Code generation failed. Error code: {}, load without the "
+                 "cache."sv,
+                 static_cast<uint32_t>(Gen.error()));
+    std::filesystem::remove(TempPath, ErrCode);
+    return std::move(*Res);
+  }
+  std::filesystem::rename(TempPath, *Path, ErrCode);
+  if (ErrCode) {
+    spdlog::warn("AOT cache {} is not published, load without the cache."sv,
+                 Path->u8string());
+    std::filesystem::remove(TempPath, ErrCode);
+    return std::move(*Res);
+  }
+  AOT::Cache::prune(*Path, Conf.getRuntimeConfigure().getAOTCacheSizeLimit());
+  if (auto Cached = LoaderEngine.parseModule(*Path);
+      Cached && (*Cached)->getSymbol()) {
+    return std::move(*Cached);
+  }
+  return std::move(*Res);
+#else
+  spdlog::warn("LLVM disabled, AOT cache is unsupported!"sv);
+  static_cast<void>(Code);
+  return nullptr;
+#endif
+}
+
 std::vector<std::pair<std::string, const AST::FunctionType &>>
 VM::unsafeGetFunctionList() const {
   std::vector<std::pair<std::string, const AST::FunctionType &>> Map;
@@ -16,6 +16,8 @@
 
 #include "common/filesystem.h"
 
+#include <chrono>
+#include <fstream>
 #include <gtest/gtest.h>
 #include <string>
 #include <string_view>
@@ -99,6 +101,55 @@ TEST(CacheTest, LocalKey) {
   EXPECT_EQ(Part.parent_path().filename().u8string(), "key"s);
 }
 
+TEST(CacheTest, Options) {
+  const auto Path = WasmEdge::AOT::Cache::getPath(
+      {}, WasmEdge::AOT::Cache::StorageScope::Global, "key"s, "O2"sv);
+  const auto Path2 = WasmEdge::AOT::Cache::getPath(
+      {}, WasmEdge::AOT::Cache::StorageScope::Global, "key"s, "O2"sv);
+  const auto Path3 = WasmEdge::AOT::Cache::getPath(
+      {}, WasmEdge::AOT::Cache::StorageScope::Global, "key"s, "O3"sv);
+  ASSERT_TRUE(Path && Path2 && Path3);
+  EXPECT_EQ(*Path, *Path2);
+  EXPECT_NE(*Path, *Path3);
+  EXPECT_NE(
+      Path->filename().u8string(),
+      "af1349b9f5f9a1a6a0404dea36dcc9499bcb25c9adc112b7cc9a93cae41f3262"s);
+}
+
+TEST(CacheTest, Prune) {
+  std::error_code ErrCode;
+  const auto Root =
+      std::filesystem::temp_directory_path() / "wasmedgeAOTCacheTest"sv;
+  std::filesystem::remove_all(Root, ErrCode);
+  ASSERT_TRUE(std::filesystem::create_directories(Root, ErrCode));
+
+  // Entries a, b, c from the least recently written, and a lock file.
+  const auto Now = std::filesystem::file_time_type::clock::now();
+  for (const auto Name : {"a"sv, "b"sv, "c"sv, "a.lock"sv}) {
+    std::ofstream(Root / Name) << std::string(100, 'x');
+  }
+  std::filesystem::last_write_time(Root / "a"sv, Now - std::chrono::hours(3));
+  std::filesystem::last_write_time(Root / "b"sv, Now - std::chrono::hours(2));
+  std::filesystem::last_write_time(Root / "c"sv, Now - std::chrono::hours(1));
+
+  // Using a makes b the least recently used one.
+  WasmEdge::AOT::Cache::touch(Root / "a"sv);
+  WasmEdge::AOT::Cache::prune(Root / "a"sv, 250);
+  EXPECT_TRUE(std::filesystem::exists(Root / "a"sv));
+  EXPECT_FALSE(std::filesystem::exists(Root / "b"sv));
+  EXPECT_TRUE(std::filesystem::exists(Root / "c"sv));
+  EXPECT_TRUE(std::filesystem::exists(Root / "a.lock"sv));
+
+  {
+    // The lock is released in destruction.
+    WasmEdge::AOT::Cache::Lock Lock(Root / "a"sv);
+  }
+  WasmEdge::AOT::Cache::Lock Lock(Root / "a"sv);
+  WasmEdge::AOT::Cache::prune(Root / "a"sv, 0);
+  EXPECT_TRUE(std::filesystem::exists(Root / "c"sv));
+  std::filesystem::remove_all(Root, ErrCode);
+}
+
 } // namespace
 
 GTEST_API_ int main(int argc, char **argv) {
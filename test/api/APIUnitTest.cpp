@@ -671,6 +671,57 @@ TEST(APICoreTest, Configure) {
   WasmEdge_ConfigureSetForceInterpreter(Conf, true);
   EXPECT_NE(WasmEdge_ConfigureIsForceInterpreter(ConfNull), true);
   EXPECT_EQ(WasmEdge_ConfigureIsForceInterpreter(Conf), true);
+  // Tests for lazy validation.
+  WasmEdge_ConfigureSetLazyValidation(ConfNull, true);
+  EXPECT_EQ(WasmEdge_ConfigureIsLazyValidation(Conf), false);
+  WasmEdge_ConfigureSetLazyValidation(Conf, true);
+  EXPECT_NE(WasmEdge_ConfigureIsLazyValidation(ConfNull), true);
+  EXPECT_EQ(WasmEdge_ConfigureIsLazyValidation(Conf), true);
+  // Tests for guard page bounds checking.
+  WasmEdge_ConfigureSetGuardPageCheck(ConfNull, true);
+  EXPECT_EQ(WasmEdge_ConfigureIsGuardPageCheck(Conf), false);
+  WasmEdge_ConfigureSetGuardPageCheck(Conf, true);
+  EXPECT_NE(WasmEdge_ConfigureIsGuardPageCheck(ConfNull), true);
+  EXPECT_EQ(WasmEdge_ConfigureIsGuardPageCheck(Conf), true);
+  // Tests for worker thread limits.
+  WasmEdge_ConfigureSetMaxThreads(ConfNull, 8U);
+  WasmEdge_ConfigureSetMaxThreads(Conf, 8U);
+  EXPECT_NE(WasmEdge_ConfigureGetMaxThreads(ConfNull), 8U);
+  EXPECT_EQ(WasmEdge_ConfigureGetMaxThreads(Conf), 8U);
+  // Tests for memory page policies.
+  WasmEdge_ConfigureSetHugePageMode(ConfNull,
+                                    WasmEdge_MemoryHugePageMode_Transparent);
+  WasmEdge_ConfigureSetHugePageMode(Conf,
+                                    WasmEdge_MemoryHugePageMode_Transparent);
+  EXPECT_NE(WasmEdge_ConfigureGetHugePageMode(ConfNull),
+            WasmEdge_MemoryHugePageMode_Transparent);
+  EXPECT_EQ(WasmEdge_ConfigureGetHugePageMode(Conf),
+            WasmEdge_MemoryHugePageMode_Transparent);
+  WasmEdge_ConfigureSetNUMALocalMemory(ConfNull, true);
+  EXPECT_EQ(WasmEdge_ConfigureIsNUMALocalMemory(Conf), false);
+  WasmEdge_ConfigureSetNUMALocalMemory(Conf, true);
+  EXPECT_NE(WasmEdge_ConfigureIsNUMALocalMemory(ConfNull), true);
+  EXPECT_EQ(WasmEdge_ConfigureIsNUMALocalMemory(Conf), true);
+  WasmEdge_ConfigureSetMemoryPoolSlots(ConfNull, 16U);
+  WasmEdge_ConfigureSetMemoryPoolSlots(Conf, 16U);
+  EXPECT_NE(WasmEdge_ConfigureGetMemoryPoolSlots(ConfNull), 16U);
+  EXPECT_EQ(WasmEdge_ConfigureGetMemoryPoolSlots(Conf), 16U);
+  WasmEdge_ConfigureSetMemoryKeepResidentPages(ConfNull, 4U);
+  WasmEdge_ConfigureSetMemoryKeepResidentPages(Conf, 4U);
+  EXPECT_NE(WasmEdge_ConfigureGetMemoryKeepResidentPages(ConfNull), 4U);
+  EXPECT_EQ(WasmEdge_ConfigureGetMemoryKeepResidentPages(Conf), 4U);
+  WasmEdge_ConfigureSetMemoryGrowthMode(ConfNull,
+                                        WasmEdge_MemoryGrowthMode_Geometric);
+  WasmEdge_ConfigureSetMemoryGrowthMode(Conf,
+                                        WasmEdge_MemoryGrowthMode_Geometric);
+  EXPECT_NE(WasmEdge_ConfigureGetMemoryGrowthMode(ConfNull),
+            WasmEdge_MemoryGrowthMode_Geometric);
+  EXPECT_EQ(WasmEdge_ConfigureGetMemoryGrowthMode(Conf),
+            WasmEdge_MemoryGrowthMode_Geometric);
+  WasmEdge_ConfigureSetMemoryGrowthStepPages(ConfNull, 32U);
+  WasmEdge_ConfigureSetMemoryGrowthStepPages(Conf, 32U);
+  EXPECT_NE(WasmEdge_ConfigureGetMemoryGrowthStepPages(ConfNull), 32U);
+  EXPECT_EQ(WasmEdge_ConfigureGetMemoryGrowthStepPages(Conf), 32U);
   // Tests for AOT compiler configurations.
   WasmEdge_ConfigureCompilerSetOptimizationLevel(
       ConfNull, WasmEdge_CompilerOptimizationLevel_Os);
@@ -0,0 +1,29 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2019-2022 Second State INC
+
+#include "common/epoch.h"
+
+#include <gtest/gtest.h>
+#include <thread>
+
+namespace {
+
+TEST(EpochTest, Deadline) {
+  using namespace std::chrono_literals;
+  const auto Target = std::chrono::steady_clock::now() + 20ms;
+  const auto Deadline = WasmEdge::Epoch::toEpoch(Target);
+  EXPECT_LT(WasmEdge::Epoch::load(), Deadline);
+  EXPECT_EQ(WasmEdge::Epoch::toEpoch(std::chrono::steady_clock::now() -
+                                     std::chrono::hours(24 * 365)),
+            0U);
+
+  // The epoch is never ahead of the time.
+  WasmEdge::Epoch::acquire();
+  while (WasmEdge::Epoch::load() < Deadline) {
+    std::this_thread::sleep_for(1ms);
+  }
+  EXPECT_GE(std::chrono::steady_clock::now(), Target);
+  WasmEdge::Epoch::release();
+}
+
+} // namespace
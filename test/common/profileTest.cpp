@@ -0,0 +1,39 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2019-2022 Second State INC
+
+#include "common/profile.h"
+
+#include <fstream>
+#include <gtest/gtest.h>
+
+namespace {
+
+TEST(ProfileTest, SaveLoad) {
+  const auto Path = std::filesystem::temp_directory_path() /
+                    std::filesystem::u8path("wasmedgeProfileTest.txt");
+  WasmEdge::Profile Prof;
+  Prof.addFunctionCount(1, 10);
+  Prof.addFunctionCount(1, 5);
+  Prof.addFunctionCount(3, 1);
+  Prof.addBranchCount(42, {7, 2});
+  Prof.addBranchCount(42, {1, 0});
+  ASSERT_TRUE(Prof.save(Path));
+
+  auto Res = WasmEdge::Profile::load(Path);
+  ASSERT_TRUE(Res);
+  EXPECT_EQ(Res->getFunctionCount(1), 15U);
+  EXPECT_EQ(Res->getFunctionCount(2), 0U);
+  EXPECT_EQ(Res->getFunctionCount(3), 1U);
+  const auto *Count = Res->getBranchCount(42);
+  ASSERT_NE(Count, nullptr);
+  EXPECT_EQ(Count->Taken, 8U);
+  EXPECT_EQ(Count->NotTaken, 2U);
+  EXPECT_EQ(Res->getBranchCount(43), nullptr);
+
+  std::ofstream(Path) << "wasmedge-profile 1\nfunction 1\n";
+  EXPECT_FALSE(WasmEdge::Profile::load(Path));
+  std::filesystem::remove(Path);
+  EXPECT_FALSE(WasmEdge::Profile::load(Path));
+}
+
+} // namespace
@@ -227,6 +227,26 @@ TEST(VM, MultipleVM) {
   EXPECT_TRUE(Result2);
 }
 
+TEST(VM, CallStackExhaustion) {
+  WasmEdge::Configure Conf;
+  WasmEdge::VM::VM VM(Conf);
+  // (func (export "_start") call 0)
+  std::array<WasmEdge::Byte, 38> Wasm{
+      0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00, 0x01, 0x04,
+      0x01, 0x60, 0x00, 0x00, 0x03, 0x02, 0x01, 0x00, 0x07, 0x0a,
+      0x01, 0x06, 0x5f, 0x73, 0x74, 0x61, 0x72, 0x74, 0x00, 0x00,
+      0x0a, 0x06, 0x01, 0x04, 0x00, 0x10, 0x00, 0x0b};
+  ASSERT_TRUE(VM.loadWasm(Wasm));
+  ASSERT_TRUE(VM.validate());
+  ASSERT_TRUE(VM.instantiate());
+  for (uint32_t I = 0; I < 2; I++) {
+    // The stack is recycled and exhausted at the same depth again.
+    auto Result = VM.execute("_start");
+    ASSERT_FALSE(Result);
+    EXPECT_EQ(Result.error(), WasmEdge::ErrCode::Value::CallStackExhausted);
+  }
+}
+
 } // namespace
 
 GTEST_API_ int main(int argc, char **argv) {
@@ -0,0 +1,124 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2019-2022 Second State INC
+
+//===-- wasmedge/test/hostcall/HostCallTest.cpp - host call allocations ---===//
+//
+// Part of the WasmEdge Project.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file contents the microbenchmark of the host function calls. It counts
+/// the heap allocations to check that the host function call path passes the
+/// arguments and returns without allocation.
+///
+//===----------------------------------------------------------------------===//
+
+#include "runtime/hostfunc.h"
+#include "runtime/instance/module.h"
+#include "vm/vm.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <gtest/gtest.h>
+#include <iostream>
+#include <memory>
+#include <new>
+
+namespace {
+
+std::atomic<uint64_t> AllocCount = 0;
+
+} // namespace
+
+void *operator new(std::size_t Size) {
+  AllocCount.fetch_add(1, std::memory_order_relaxed);
+  if (void *Ptr = std::malloc(Size ? Size : 1)) {
+    return Ptr;
+  }
+  throw std::bad_alloc();
+}
+void operator delete(void *Ptr) noexcept { std::free(Ptr); }
+void operator delete(void *Ptr, std::size_t) noexcept { std::free(Ptr); }
+
+namespace {
+
+// (module
+//   (import "env" "add" (func $add (param i32 i32) (result i32)))
+//   (func (export "run") (param $n i32) (result i32) (local $acc i32)
+//     (block
+//       (loop
+//         (br_if 1 (i32.eqz (local.get $n)))
+//         (local.set $acc (call $add (local.get $acc) (local.get $n)))
+//         (local.set $n (i32.sub (local.get $n) (i32.const 1)))
+//         (br 0)))
+//     (local.get $acc)))
+std::array<WasmEdge::Byte, 86> HostCallWasm{
+    0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00, 0x01, 0x0c, 0x02, 0x60,
+    0x02, 0x7f, 0x7f, 0x01, 0x7f, 0x60, 0x01, 0x7f, 0x01, 0x7f, 0x02, 0x0b,
+    0x01, 0x03, 0x65, 0x6e, 0x76, 0x03, 0x61, 0x64, 0x64, 0x00, 0x00, 0x03,
+    0x02, 0x01, 0x01, 0x07, 0x07, 0x01, 0x03, 0x72, 0x75, 0x6e, 0x00, 0x01,
+    0x0a, 0x24, 0x01, 0x22, 0x01, 0x01, 0x7f, 0x02, 0x40, 0x03, 0x40, 0x20,
+    0x00, 0x45, 0x0d, 0x01, 0x20, 0x01, 0x20, 0x00, 0x10, 0x00, 0x21, 0x01,
+    0x20, 0x00, 0x41, 0x01, 0x6b, 0x21, 0x00, 0x0c, 0x00, 0x0b, 0x0b, 0x20,
+    0x01, 0x0b,
+};
+
+class HostAdd : public WasmEdge::Runtime::HostFunction<HostAdd> {
+public:
+  WasmEdge::Expect<uint32_t> body(const WasmEdge::Runtime::CallingFrame &,
+                                  uint32_t A, uint32_t B) {
+    return A + B;
+  }
+};
+
+/// Execute the `run` function and return the heap allocations count.
+uint64_t countAllocations(WasmEdge::VM::VM &VM, uint32_t N) {
+  const uint64_t Start = AllocCount.load(std::memory_order_relaxed);
+  auto Res = VM.execute("run", std::initializer_list<WasmEdge::ValVariant>{N},
+                        {WasmEdge::ValType(WasmEdge::TypeCode::I32)});
+  const uint64_t End = AllocCount.load(std::memory_order_relaxed);
+  EXPECT_TRUE(Res);
+  if (Res) {
+    EXPECT_EQ((*Res)[0].first.get<uint32_t>(),
+              static_cast<uint32_t>(uint64_t(N) * (N + 1) / 2));
+  }
+  return End - Start;
+}
+
+TEST(HostCallTest, ZeroAllocationPerCall) {
+  WasmEdge::Configure Conf;
+  WasmEdge::VM::VM VM(Conf);
+  WasmEdge::Runtime::Instance::ModuleInstance Env("env");
+  Env.addHostFunc("add", std::make_unique<HostAdd>());
+  ASSERT_TRUE(VM.registerModule(Env));
+  ASSERT_TRUE(VM.loadWasm(HostCallWasm));
+  ASSERT_TRUE(VM.validate());
+  ASSERT_TRUE(VM.instantiate());
+
+  // Warm up the value stack and the frame stack.
+  countAllocations(VM, 1000);
+
+  // The allocations of the execution itself are the same for any calls count.
+  const uint64_t Base = countAllocations(VM, 1);
+  const uint64_t Many = countAllocations(VM, 10000);
+  EXPECT_EQ(Many, Base);
+
+  const auto Start = std::chrono::steady_clock::now();
+  countAllocations(VM, 1000000);
+  const auto Elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now() - Start);
+  std::cout << "host call: " << Elapsed.count() / 1000000 << " ns/call"
+            << std::endl;
+}
+
+} // namespace
+
+GTEST_API_ int main(int argc, char **argv) {
+  WasmEdge::Log::setErrorLoggingLevel();
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
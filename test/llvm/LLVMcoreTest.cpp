@@ -32,6 +32,7 @@
 #include <memory>
 #include <string>
 #include <string_view>
+#include <thread>
 #include <type_traits>
 #include <utility>
 #include <vector>
@@ -527,6 +528,115 @@ TEST(AsyncExecute, CustomWasmInterruptTest) {
   EXPECT_NO_THROW(std::filesystem::remove(Path));
 }
 
+std::array<WasmEdge::Byte, 61> FibWasm{
+    0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00, 0x01, 0x06, 0x01, 0x60,
+    0x01, 0x7f, 0x01, 0x7f, 0x03, 0x02, 0x01, 0x00, 0x07, 0x07, 0x01, 0x03,
+    0x66, 0x69, 0x62, 0x00, 0x00, 0x0a, 0x1e, 0x01, 0x1c, 0x00, 0x20, 0x00,
+    0x41, 0x02, 0x49, 0x04, 0x7f, 0x20, 0x00, 0x05, 0x20, 0x00, 0x41, 0x01,
+    0x6b, 0x10, 0x00, 0x20, 0x00, 0x41, 0x02, 0x6b, 0x10, 0x00, 0x6a, 0x0b,
+    0x0b};
+
+TEST(TieredJIT, TierUpTest) {
+  WasmEdge::Configure Conf;
+  Conf.getRuntimeConfigure().setEnableJIT(true);
+  Conf.getRuntimeConfigure().setEnableTieredJIT(true);
+  Conf.getRuntimeConfigure().setTierUpThreshold(10);
+
+  WasmEdge::VM::VM VM(Conf);
+  ASSERT_TRUE(VM.loadWasm(FibWasm));
+  ASSERT_TRUE(VM.validate());
+  ASSERT_TRUE(VM.instantiate());
+  const auto *FuncInst = VM.getActiveModule()->findFuncExports("fib");
+  ASSERT_NE(FuncInst, nullptr);
+  EXPECT_TRUE(FuncInst->isWasmFunction());
+
+  const std::array<ValVariant, 1> Params = {UINT32_C(20)};
+  const std::array<ValType, 1> ParamTypes = {TypeCode::I32};
+  auto Result = VM.execute("fib", Params, ParamTypes);
+  ASSERT_TRUE(Result);
+  EXPECT_EQ((*Result)[0].first.get<uint32_t>(), 6765U);
+
+  // Wait for the background compiling of the hot function.
+  const auto Deadline =
+      std::chrono::steady_clock::now() + std::chrono::seconds(30);
+  while (!FuncInst->getTierUpCode() &&
+         std::chrono::steady_clock::now() < Deadline) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  EXPECT_NE(FuncInst->getTierUpCode(), nullptr);
+  Result = VM.execute("fib", Params, ParamTypes);
+  ASSERT_TRUE(Result);
+  EXPECT_EQ((*Result)[0].first.get<uint32_t>(), 6765U);
+  VM.cleanup();
+}
+
+TEST(LazyJIT, FirstCallTest) {
+  WasmEdge::Configure Conf;
+  Conf.getRuntimeConfigure().setEnableJIT(true);
+  Conf.getRuntimeConfigure().setEnableLazyJIT(true);
+
+  WasmEdge::VM::VM VM(Conf);
+  ASSERT_TRUE(VM.loadWasm(FibWasm));
+  ASSERT_TRUE(VM.validate());
+  ASSERT_TRUE(VM.instantiate());
+  const auto *FuncInst = VM.getActiveModule()->findFuncExports("fib");
+  ASSERT_NE(FuncInst, nullptr);
+  EXPECT_TRUE(FuncInst->isCompiledFunction());
+
+  // Compiled in the first call, and the recursive calls go through the stub.
+  const std::array<ValVariant, 1> Params = {UINT32_C(20)};
+  const std::array<ValType, 1> ParamTypes = {TypeCode::I32};
+  for (int I = 0; I < 2; ++I) {
+    auto Result = VM.execute("fib", Params, ParamTypes);
+    ASSERT_TRUE(Result);
+    EXPECT_EQ((*Result)[0].first.get<uint32_t>(), 6765U);
+  }
+  VM.cleanup();
+}
+
+TEST(FatBinary, HostLevelTest) {
+  WasmEdge::Configure Conf;
+  Conf.getCompilerConfigure().setFatBinary(true);
+  Conf.getCompilerConfigure().setOutputFormat(
+      CompilerConfigure::OutputFormat::Wasm);
+
+  WasmEdge::Loader::Loader Loader(Conf);
+  WasmEdge::Validator::Validator ValidatorEngine(Conf);
+  WasmEdge::LLVM::Compiler Compiler(Conf);
+  WasmEdge::LLVM::CodeGen CodeGen(Conf);
+  auto Path = std::filesystem::temp_directory_path() /
+              std::filesystem::u8path("AOTcoreTest.fat.wasm");
+  auto Module = *Loader.parseModule(FibWasm);
+  ASSERT_TRUE(ValidatorEngine.validate(*Module));
+  auto Data = Compiler.compile(*Module);
+  ASSERT_TRUE(Data);
+  ASSERT_TRUE(CodeGen.codegen(FibWasm, std::move(*Data), Path));
+
+  // The highest target level supported by the host is loaded.
+  auto Expected = WasmEdge::AOT::TargetLevel::Generic;
+  for (const auto Level : WasmEdge::AOT::kFatTargetLevels) {
+    if (WasmEdge::AOT::isHostSupported(Level)) {
+      Expected = Level;
+    }
+  }
+  auto FatModule = Loader.parseModule(Path);
+  ASSERT_TRUE(FatModule);
+  EXPECT_EQ((*FatModule)->getAOTSection().getTargetLevel(),
+            static_cast<uint8_t>(Expected));
+
+  WasmEdge::VM::VM VM(Conf);
+  ASSERT_TRUE(VM.loadWasm(Path));
+  ASSERT_TRUE(VM.validate());
+  ASSERT_TRUE(VM.instantiate());
+  const std::array<ValVariant, 1> Params = {UINT32_C(20)};
+  const std::array<ValType, 1> ParamTypes = {TypeCode::I32};
+  auto Result = VM.execute("fib", Params, ParamTypes);
+  ASSERT_TRUE(Result);
+  EXPECT_EQ((*Result)[0].first.get<uint32_t>(), 6765U);
+  VM.cleanup();
+  EXPECT_NO_THROW(std::filesystem::remove(Path));
+}
+
 } // namespace
 
 GTEST_API_ int main(int argc, char **argv) {
@@ -4,7 +4,9 @@
 #include "common/configure.h"
 #include "runtime/instance/memory.h"
 
+#include <cstring>
 #include <gtest/gtest.h>
+#include <vector>
 
 namespace {
 
@@ -42,6 +44,137 @@ TEST(MemLimitTest, Limit__Pages) {
   ASSERT_FALSE(Inst6.growPage(0xFFFFFFFF));
 }
 
+TEST(MemLimitTest, Policy__Pages) {
+  using MemInst = WasmEdge::Runtime::Instance::MemoryInstance;
+  using WasmEdge::Allocator;
+  for (auto Mode : {Allocator::HugePage::None, Allocator::HugePage::Transparent,
+                    Allocator::HugePage::HugeTLB}) {
+    Allocator::Policy Policy;
+    Policy.HugePageMode = Mode;
+    Policy.NUMALocal = true;
+    // The huge pages fall back to the normal pages if not available.
+    MemInst Inst(WasmEdge::AST::MemoryType(1), UINT32_C(65536), Policy);
+    ASSERT_FALSE(Inst.getDataPtr() == nullptr);
+    ASSERT_TRUE(Inst.growPage(63));
+    ASSERT_TRUE(Inst.growPage(64));
+    EXPECT_EQ(Inst.getPageSize(), 128U);
+    auto *Data = Inst.getDataPtr();
+    for (uint32_t I = 0; I < 128U; ++I) {
+      EXPECT_EQ(Data[I * UINT32_C(65536)], 0U);
+      Data[I * UINT32_C(65536)] = static_cast<uint8_t>(I);
+    }
+    for (uint32_t I = 0; I < 128U; ++I) {
+      EXPECT_EQ(Data[I * UINT32_C(65536)], static_cast<uint8_t>(I));
+    }
+  }
+}
+
+TEST(MemLimitTest, Pool__Slots) {
+  using MemInst = WasmEdge::Runtime::Instance::MemoryInstance;
+  WasmEdge::Allocator::Policy Policy;
+  Policy.PoolSlots = 2;
+  Policy.KeepResidentPages = 2;
+  uint8_t *Recycled = nullptr;
+  for (uint32_t Pages : {4U, 1U, 3U}) {
+    MemInst Inst(WasmEdge::AST::MemoryType(Pages), UINT32_C(65536), Policy);
+    auto *Data = Inst.getDataPtr();
+    ASSERT_FALSE(Data == nullptr);
+    if (Recycled != nullptr) {
+      // The slot is recycled and the data is zeroed.
+      EXPECT_EQ(Data, Recycled);
+    }
+    for (uint32_t I = 0; I < Pages * UINT32_C(65536); I += 4096) {
+      EXPECT_EQ(Data[I], 0U);
+      Data[I] = 0xFFU;
+    }
+    ASSERT_TRUE(Inst.growPage(1));
+    EXPECT_EQ(Data[Pages * UINT32_C(65536)], 0U);
+    Recycled = Data;
+  }
+}
+
+TEST(MemLimitTest, Growth__Headroom) {
+  using MemInst = WasmEdge::Runtime::Instance::MemoryInstance;
+  using WasmEdge::Allocator;
+  for (auto Mode : {Allocator::Growth::Fixed, Allocator::Growth::Geometric}) {
+    Allocator::Policy Policy;
+    Policy.GrowthMode = Mode;
+    Policy.GrowthStepPages = 16;
+    // The committed headroom is invisible to the memory size and bounds.
+    MemInst Inst(WasmEdge::AST::MemoryType(1, 40), UINT32_C(65536), Policy);
+    ASSERT_FALSE(Inst.getDataPtr() == nullptr);
+    for (uint32_t Pages = 2; Pages <= 40; ++Pages) {
+      ASSERT_TRUE(Inst.growPage(1));
+      EXPECT_EQ(Inst.getPageSize(), Pages);
+      EXPECT_TRUE(Inst.checkAccessBound((Pages - 1) * UINT32_C(65536), 1));
+      EXPECT_FALSE(Inst.checkAccessBound(Pages * UINT32_C(65536), 1));
+      auto *Data = Inst.getDataPtr();
+      EXPECT_EQ(Data[(Pages - 1) * UINT32_C(65536)], 0U);
+      Data[(Pages - 1) * UINT32_C(65536)] = 0xFFU;
+      if (Pages == 20) {
+        // Drop the headroom and commit exactly from now on.
+        Inst.setExactCommit();
+      }
+    }
+    EXPECT_FALSE(Inst.growPage(1));
+    EXPECT_EQ(Inst.getPageSize(), 40U);
+  }
+}
+
+TEST(MemLimitTest, Memory64__Bounds) {
+  using MemInst = WasmEdge::Runtime::Instance::MemoryInstance;
+  WasmEdge::AST::MemoryType MType(2, 4);
+  MType.getLimit().set64(true);
+  // The 64-bit memory is reserved up to the maximum without the guard region.
+  MemInst Inst(MType);
+  ASSERT_FALSE(Inst.getDataPtr() == nullptr);
+  EXPECT_TRUE(Inst.is64());
+  EXPECT_FALSE(Inst.isGuarded());
+  const uint64_t Size = UINT64_C(2) * 65536;
+  EXPECT_TRUE(Inst.checkAccessBound(Size - 8, 8));
+  EXPECT_FALSE(Inst.checkAccessBound(Size - 7, 8));
+  EXPECT_FALSE(Inst.checkAccessBound(UINT64_C(1) << 32, 1));
+  EXPECT_FALSE(Inst.checkAccessBound(UINT64_MAX, 1));
+  EXPECT_FALSE(Inst.checkAccessBound(1, UINT64_MAX));
+  EXPECT_TRUE(Inst.storeValue(UINT64_C(0x0123456789ABCDEF), Size - 8));
+  EXPECT_FALSE(Inst.storeValue(UINT64_C(0), (UINT64_C(1) << 32) + 8));
+  ASSERT_TRUE(Inst.growPage(2));
+  EXPECT_FALSE(Inst.growPage(1));
+  uint64_t Value = 0;
+  EXPECT_TRUE(Inst.loadValue(Value, Size - 8));
+  EXPECT_EQ(Value, UINT64_C(0x0123456789ABCDEF));
+  EXPECT_TRUE(Inst.loadValue(Value, Size * 2 - 8));
+  EXPECT_EQ(Value, 0U);
+}
+
+TEST(MemLimitTest, Bulk__Kernels) {
+  using WasmEdge::BulkMemory;
+  const uint64_t Threshold = BulkMemory::getStreamingThreshold();
+  // Lower the threshold to cover the streaming tier.
+  BulkMemory::setStreamingThreshold(4096);
+  std::vector<uint8_t> Init(80000);
+  for (size_t I = 0; I < Init.size(); ++I) {
+    Init[I] = static_cast<uint8_t>(I * 7 + 3);
+  }
+  for (uint64_t Len : {0, 1, 2, 3, 5, 8, 13, 16, 17, 31, 32, 33, 100, 4095,
+                       4096, 5000, 70000}) {
+    for (uint64_t Src : {0, 1, 9, 64}) {
+      for (uint64_t Dst : {0, 1, 9, 64, 8192}) {
+        auto Buf = Init, Ref = Init;
+        BulkMemory::copy(Buf.data() + Dst, Buf.data() + Src, Len);
+        std::memmove(Ref.data() + Dst, Ref.data() + Src, Len);
+        EXPECT_EQ(Buf, Ref) << Len << " " << Src << " " << Dst;
+        Buf = Init;
+        Ref = Init;
+        BulkMemory::fill(Buf.data() + Dst, 0xA5U, Len);
+        std::memset(Ref.data() + Dst, 0xA5, Len);
+        EXPECT_EQ(Buf, Ref) << Len << " " << Dst;
+      }
+    }
+  }
+  BulkMemory::setStreamingThreshold(Threshold);
+}
+
 } // namespace
 
 GTEST_API_ int main(int argc, char **argv) {
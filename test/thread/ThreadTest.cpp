@@ -22,9 +22,13 @@
 
 #include "gtest/gtest.h"
 
+#include <atomic>
 #include <fstream>
 #include <memory>
+#include <mutex>
+#include <set>
 #include <string>
+#include <thread>
 #include <vector>
 
 namespace {
@@ -226,6 +230,60 @@ TEST(AsyncExecute, GasThreadTest) {
   }
 }
 
+TEST(AsyncExecute, ThreadPoolTest) {
+  WasmEdge::Configure Conf;
+  Conf.getRuntimeConfigure().setMaxThreads(2);
+  WasmEdge::VM::VM VM(Conf);
+  ASSERT_TRUE(VM.loadWasm(MersenneTwister19937));
+  ASSERT_TRUE(VM.validate());
+  ASSERT_TRUE(VM.instantiate());
+  {
+    std::vector<WasmEdge::Async<WasmEdge::Expect<std::vector<
+        std::pair<WasmEdge::ValVariant, WasmEdge::ValType>>>>>
+        AsyncResults;
+    for (uint64_t Round = 0; Round < 4; ++Round) {
+      for (uint64_t Index = 0; Index < Answers.size(); ++Index) {
+        AsyncResults.push_back(VM.asyncExecute(
+            "mt19937",
+            std::initializer_list<WasmEdge::ValVariant>{
+                UINT32_C(2504) * Index, UINT64_C(5489),
+                UINT64_C(100000) + Index},
+            {WasmEdge::ValType(WasmEdge::TypeCode::I32),
+             WasmEdge::ValType(WasmEdge::TypeCode::I64),
+             WasmEdge::ValType(WasmEdge::TypeCode::I64)}));
+      }
+    }
+    for (uint64_t Index = 0; Index < AsyncResults.size(); ++Index) {
+      auto Result = AsyncResults[Index].get();
+      ASSERT_TRUE(Result);
+      ASSERT_EQ((*Result)[0].second.getCode(), WasmEdge::TypeCode::I64);
+      EXPECT_EQ((*Result)[0].first.get<uint64_t>(),
+                Answers[Index % Answers.size()]);
+    }
+  }
+  // The worker threads are reused and limited by the configuration.
+  EXPECT_LE(VM.getExecutor().getAsyncPool().getThreadNum(), 2U);
+}
+
+TEST(ThreadPool, ReuseTest) {
+  WasmEdge::ThreadPool Pool(3);
+  std::mutex Mutex;
+  std::set<std::thread::id> ThreadIds;
+  std::atomic<uint32_t> Count = 0;
+  for (uint32_t I = 0; I < 64; ++I) {
+    Pool.submit([&]() {
+      std::unique_lock<std::mutex> Lock(Mutex);
+      ThreadIds.insert(std::this_thread::get_id());
+      Count++;
+    });
+  }
+  while (Count.load() < 64) {
+    std::this_thread::yield();
+  }
+  EXPECT_LE(Pool.getThreadNum(), 3U);
+  EXPECT_LE(ThreadIds.size(), 3U);
+}
+
 #ifdef WASMEDGE_USE_LLVM
 
 TEST(AOTAsyncExecute, ThreadTest) {